@@ -0,0 +1,68 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "values.hpp"
+
+using namespace unmoving;
+
+// times one use of a binary operation per iteration
+template <typename Operation>
+static void binary_operation(benchmark::State& state, Operation operation) {
+    auto lhs = benchmarks::small_values(1);
+    auto rhs = benchmarks::small_values(2);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed result = operation(lhs[i], rhs[i]);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// times one use of a compound assignment operation per iteration, so the result depends on the last one
+template <typename Operation>
+static void compound_operation(benchmark::State& state, Operation operation) {
+    auto rhs = benchmarks::small_values(2);
+    PSXFixed value = 1.0_fx;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        operation(value, rhs[i]);
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(binary_operation, add, [](PSXFixed lhs, PSXFixed rhs) { return lhs + rhs; });
+BENCHMARK_CAPTURE(binary_operation, subtract, [](PSXFixed lhs, PSXFixed rhs) { return lhs - rhs; });
+BENCHMARK_CAPTURE(binary_operation, multiply, [](PSXFixed lhs, PSXFixed rhs) { return lhs * rhs; });
+BENCHMARK_CAPTURE(binary_operation, divide, [](PSXFixed lhs, PSXFixed rhs) { return lhs / rhs; });
+BENCHMARK_CAPTURE(binary_operation, multiply_integer, [](PSXFixed lhs, PSXFixed rhs) {
+    return lhs * (rhs.to_integer() | 1);
+});
+BENCHMARK_CAPTURE(binary_operation, divide_integer, [](PSXFixed lhs, PSXFixed rhs) {
+    return lhs / (rhs.to_integer() | 1);
+});
+BENCHMARK_CAPTURE(binary_operation, negate, [](PSXFixed lhs, PSXFixed) { return -lhs; });
+
+BENCHMARK_CAPTURE(compound_operation, add_assign, [](PSXFixed& value, PSXFixed rhs) { value += rhs; });
+BENCHMARK_CAPTURE(compound_operation, subtract_assign, [](PSXFixed& value, PSXFixed rhs) { value -= rhs; });
+BENCHMARK_CAPTURE(compound_operation, multiply_assign, [](PSXFixed& value, PSXFixed rhs) { value *= rhs; });
+BENCHMARK_CAPTURE(compound_operation, divide_assign, [](PSXFixed& value, PSXFixed rhs) { value /= rhs; });
+BENCHMARK_CAPTURE(compound_operation, increment, [](PSXFixed& value, PSXFixed) { ++value; });
+BENCHMARK_CAPTURE(compound_operation, decrement, [](PSXFixed& value, PSXFixed) { --value; });
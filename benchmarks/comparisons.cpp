@@ -0,0 +1,43 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "values.hpp"
+
+using namespace unmoving;
+
+// times one comparison per iteration
+template <typename Comparison>
+static void comparison(benchmark::State& state, Comparison compare) {
+    // a narrow range, so that some of the values are equal
+    auto lhs = benchmarks::random_values(1, -8, 8);
+    auto rhs = benchmarks::random_values(2, -8, 8);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bool result = compare(lhs[i], rhs[i]);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(comparison, equal, [](PSXFixed lhs, PSXFixed rhs) { return lhs == rhs; });
+BENCHMARK_CAPTURE(comparison, not_equal, [](PSXFixed lhs, PSXFixed rhs) { return lhs != rhs; });
+BENCHMARK_CAPTURE(comparison, less, [](PSXFixed lhs, PSXFixed rhs) { return lhs < rhs; });
+BENCHMARK_CAPTURE(comparison, less_equal, [](PSXFixed lhs, PSXFixed rhs) { return lhs <= rhs; });
+BENCHMARK_CAPTURE(comparison, greater, [](PSXFixed lhs, PSXFixed rhs) { return lhs > rhs; });
+BENCHMARK_CAPTURE(comparison, greater_equal, [](PSXFixed lhs, PSXFixed rhs) { return lhs >= rhs; });
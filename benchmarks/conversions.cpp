@@ -0,0 +1,196 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "values.hpp"
+
+using namespace unmoving;
+
+static void from_double(benchmark::State& state) {
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<double> distribution(PSXFixed::FRACTIONAL_MIN, PSXFixed::FRACTIONAL_MAX);
+    benchmarks::Values<double> values;
+    for (auto& value : values) {
+        value = distribution(engine);
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed result(values[i]);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(from_double);
+
+static void from_integer(benchmark::State& state) {
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> distribution(PSXFixed::DECIMAL_MIN, PSXFixed::DECIMAL_MAX);
+    benchmarks::Values<int> values;
+    for (auto& value : values) {
+        value = distribution(engine);
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed result = PSXFixed::from_integer(values[i]);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(from_integer);
+
+static void to_double(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        double result = (double)values[i];
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(to_double);
+
+static void to_integer(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed::UnderlyingType result = values[i].to_integer();
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(to_integer);
+
+static void to_c_str(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    char buffer[16] = {};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bool result = values[i].to_c_str(buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(buffer);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(to_c_str);
+
+static void to_shortest_chars(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    char buffer[16] = {};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        ToCharsResult result = values[i].to_shortest_chars(buffer, buffer + sizeof(buffer));
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(buffer);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(to_shortest_chars);
+
+static void to_chars(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    char buffer[16] = {};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        ToCharsResult result = values[i].to_chars(buffer, buffer + sizeof(buffer));
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(buffer);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(to_chars);
+
+static void to_chars_precision_3(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    char buffer[16] = {};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        ToCharsResult result = values[i].to_chars(buffer, buffer + sizeof(buffer), 3);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(buffer);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(to_chars_precision_3);
+
+// for comparison, formatting with snprintf() as to_c_str() used to
+static void snprintf_reference(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    char buffer[16] = {};
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed::UnderlyingType raw = values[i];
+        int whole = raw / PSXFixed::SCALE;
+        std::uint32_t magnitude = raw < 0 ? 0u - (std::uint32_t)raw : (std::uint32_t)raw;
+        unsigned fraction = (unsigned)((std::uint64_t)(magnitude % PSXFixed::SCALE) * 1'000'000 / PSXFixed::SCALE);
+        int result = raw < 0 and whole == 0
+            ? std::snprintf(buffer, sizeof(buffer), "-0.%06u", fraction)
+            : std::snprintf(buffer, sizeof(buffer), "%d.%06u", whole, fraction);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(buffer);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(snprintf_reference);
+
+static void from_chars(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    benchmarks::Values<std::string> strings;
+    for (std::size_t i = 0; i < benchmarks::COUNT; i++) {
+        char buffer[16] = {};
+        strings[i].assign(buffer, values[i].to_shortest_chars(buffer, buffer + sizeof(buffer)).ptr);
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed result;
+        PSXFixed::from_chars(strings[i].data(), strings[i].data() + strings[i].size(), result);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(from_chars);
+
+// for comparison, parsing with strtod() and converting from double
+static void strtod_reference(benchmark::State& state) {
+    auto values = benchmarks::random_values(1, INT32_MIN, INT32_MAX);
+    benchmarks::Values<std::string> strings;
+    for (std::size_t i = 0; i < benchmarks::COUNT; i++) {
+        char buffer[16] = {};
+        strings[i].assign(buffer, values[i].to_shortest_chars(buffer, buffer + sizeof(buffer)).ptr);
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        PSXFixed result(std::strtod(strings[i].c_str(), nullptr));
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(strtod_reference);
@@ -0,0 +1,86 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <unmoving/PSXFixed.hpp>
+#include <unmoving/exponential.hpp>
+
+#include "values.hpp"
+
+using namespace unmoving;
+
+// exponents whose powers of two are in range
+static benchmarks::Values<PSXFixed> exponents() {
+    return benchmarks::random_values(1, -12 * 4096, 18 * 4096);
+}
+
+// exponents small enough for pow() of any base
+static benchmarks::Values<PSXFixed> small_exponents() {
+    return benchmarks::random_values(1, -12 * 256, 18 * 256);
+}
+
+// values which have logarithms
+static benchmarks::Values<PSXFixed> positive_values() {
+    return benchmarks::random_values(2, 1, INT32_MAX);
+}
+
+// the same values, for comparing with the standard library
+static benchmarks::Values<double> as_double(const benchmarks::Values<PSXFixed>& values) {
+    benchmarks::Values<double> converted;
+    for (std::size_t i = 0; i < benchmarks::COUNT; i++) {
+        converted[i] = (double)values[i];
+    }
+    return converted;
+}
+
+// times one use of a function per iteration
+template <typename T, typename Function>
+static void unary_function(benchmark::State& state, benchmarks::Values<T> values, Function function) {
+    std::size_t i = 0;
+    for (auto _ : state) {
+        T result = function(values[i]);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// the same as unary_function(), for functions of two arguments
+template <typename T, typename Function>
+static void binary_function(benchmark::State& state, benchmarks::Values<T> lhs, benchmarks::Values<T> rhs, Function function) {
+    std::size_t i = 0;
+    for (auto _ : state) {
+        T result = function(lhs[i], rhs[i]);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) % benchmarks::COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(unary_function, exp2, exponents(), [](PSXFixed x) { return unmoving::exp2(x); });
+BENCHMARK_CAPTURE(unary_function, std_exp2, as_double(exponents()), [](double x) { return std::exp2(x); });
+BENCHMARK_CAPTURE(unary_function, exp, exponents(), [](PSXFixed x) { return unmoving::exp(x); });
+BENCHMARK_CAPTURE(unary_function, std_exp, as_double(exponents()), [](double x) { return std::exp(x); });
+BENCHMARK_CAPTURE(unary_function, log2, positive_values(), [](PSXFixed x) { return unmoving::log2(x); });
+BENCHMARK_CAPTURE(unary_function, std_log2, as_double(positive_values()), [](double x) { return std::log2(x); });
+BENCHMARK_CAPTURE(unary_function, log, positive_values(), [](PSXFixed x) { return unmoving::log(x); });
+BENCHMARK_CAPTURE(unary_function, std_log, as_double(positive_values()), [](double x) { return std::log(x); });
+BENCHMARK_CAPTURE(binary_function, pow, positive_values(), small_exponents(), [](PSXFixed x, PSXFixed y) {
+    return unmoving::pow(x, y);
+});
+BENCHMARK_CAPTURE(binary_function, std_pow, as_double(positive_values()), as_double(small_exponents()), [](double x, double y) {
+    return std::pow(x, y);
+});
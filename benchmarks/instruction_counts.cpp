@@ -0,0 +1,136 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * Runs one PSXFixed operation a given number of times, for counting the
+ * instructions it takes under an emulator (see instruction_counts.py).
+ *
+ * Usage: instruction-counts <operation> <iterations>
+ *        instruction-counts --list
+ *
+ * Each operation is a separate function which isn't inlined, so that the
+ * loop calling it costs the same for every operation and can be measured
+ * separately with the "baseline" operation. Nothing is printed while
+ * running, and only the C library is used, so that the instructions
+ * executed outside of the operations are the same for any iteration count.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unmoving/PSXFixed.hpp>
+
+using namespace unmoving;
+
+// a power of two, so that stepping through the inputs is only a mask
+static constexpr std::size_t COUNT = 64;
+
+static PSXFixed lhs[COUNT], rhs[COUNT];
+static int integers[COUNT];
+static double doubles[COUNT];
+static char strings[COUNT][16];
+static std::size_t lengths[COUNT];
+
+// results are written here so that the operations can't be optimised away
+static volatile std::int32_t sink;
+static char buffer[16];
+
+// fills the inputs with pseudo-random values, the same on every run
+static void generate_inputs() {
+    std::uint32_t state = 1;
+    auto next = [&state]() {
+        state = state * 1'103'515'245u + 12'345u;
+        return state;
+    };
+    for (std::size_t i = 0; i < COUNT; i++) {
+        // values whose products and quotients mostly fit in PSXFixed, and never zero
+        lhs[i] = (PSXFixed::UnderlyingType)(next() % 0x200000u) - 0x100000;
+        rhs[i] = (PSXFixed::UnderlyingType)(next() % 0x200000u) - 0x100000;
+        if (rhs[i] == 0) { rhs[i] = 1; }
+        integers[i] = (int)(next() % 1'000u) - 500;
+        doubles[i] = (double)lhs[i] / PSXFixed::SCALE;
+        lengths[i] = (std::size_t)(lhs[i].to_shortest_chars(strings[i], strings[i] + 16).ptr - strings[i]);
+    }
+}
+
+#define OPERATION(name) [[gnu::noinline]] static void name(std::size_t i)
+
+OPERATION(baseline) { sink = lhs[i]; }
+OPERATION(add) { sink = lhs[i] + rhs[i]; }
+OPERATION(subtract) { sink = lhs[i] - rhs[i]; }
+OPERATION(multiply) { sink = lhs[i] * rhs[i]; }
+OPERATION(divide) { sink = lhs[i] / rhs[i]; }
+OPERATION(multiply_integer) { sink = lhs[i] * integers[i]; }
+OPERATION(divide_integer) { sink = lhs[i] / (integers[i] | 1); }
+OPERATION(negate) { sink = -lhs[i]; }
+OPERATION(compare) { sink = lhs[i] < rhs[i]; }
+OPERATION(from_integer) { sink = PSXFixed::from_integer(integers[i]); }
+OPERATION(to_integer) { sink = lhs[i].to_integer(); }
+OPERATION(from_double) { sink = PSXFixed(doubles[i]); }
+OPERATION(to_double) { sink = (std::int32_t)(double)lhs[i]; }
+OPERATION(to_c_str) { sink = lhs[i].to_c_str(buffer, sizeof(buffer)); }
+OPERATION(to_shortest_chars) { sink = (std::int32_t)(lhs[i].to_shortest_chars(buffer, buffer + sizeof(buffer)).ptr - buffer); }
+OPERATION(from_chars) {
+    PSXFixed value;
+    PSXFixed::from_chars(strings[i], strings[i] + lengths[i], value);
+    sink = value;
+}
+
+#undef OPERATION
+
+static const struct {
+    const char* name;
+    void (*run)(std::size_t);
+} OPERATIONS[] = {
+    {"baseline", baseline},
+    {"add", add},
+    {"subtract", subtract},
+    {"multiply", multiply},
+    {"divide", divide},
+    {"multiply_integer", multiply_integer},
+    {"divide_integer", divide_integer},
+    {"negate", negate},
+    {"compare", compare},
+    {"from_integer", from_integer},
+    {"to_integer", to_integer},
+    {"from_double", from_double},
+    {"to_double", to_double},
+    {"to_c_str", to_c_str},
+    {"to_shortest_chars", to_shortest_chars},
+    {"from_chars", from_chars},
+};
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 and std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& operation : OPERATIONS) {
+            std::puts(operation.name);
+        }
+        return EXIT_SUCCESS;
+    }
+    if (argc != 3) {
+        std::fputs("usage: instruction-counts <operation> <iterations> | --list\n", stderr);
+        return EXIT_FAILURE;
+    }
+    unsigned long iterations = std::strtoul(argv[2], nullptr, 10);
+    for (const auto& operation : OPERATIONS) {
+        if (std::strcmp(argv[1], operation.name) == 0) {
+            generate_inputs();
+            for (unsigned long i = 0; i < iterations; i++) {
+                operation.run(i % COUNT);
+            }
+            return EXIT_SUCCESS;
+        }
+    }
+    std::fprintf(stderr, "unknown operation: %s\n", argv[1]);
+    return EXIT_FAILURE;
+}
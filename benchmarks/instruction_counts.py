@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+This script forms part of Unmoving
+
+Counts the instructions each PSXFixed operation takes on a MIPS R3000 (the
+PlayStation's CPU), by running the instruction-counts program built for
+little-endian MIPS under qemu user-mode emulation with the execlog plugin,
+which logs every instruction executed.
+
+Each operation is run twice, for N and 2N iterations, so that the difference
+between the runs is only the cost of N iterations. The cost of the loop
+calling the operation (the "baseline" operation) is then taken away.
+
+The cycle estimate assumes one cycle per instruction, plus the time the
+R3000 takes to multiply and divide (results are assumed to be read straight
+away, so this is an upper bound for those). Calls into the libgcc helpers
+for 64-bit and soft-float arithmetic are counted too, as they are usually
+the first sign of a slow operation.
+
+Results can be written to JSON and compared with those of another version:
+
+    instruction_counts.py --binary instruction-counts --plugin libexeclog.so --json new.json --compare old.json
+
+Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+"""
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+# libgcc routines which mean 64-bit or floating-point arithmetic is being done the slow way
+HELPERS = (
+    "__muldi3", "__divdi3", "__udivdi3", "__moddi3", "__umoddi3",
+    "__ashldi3", "__ashrdi3", "__lshrdi3",
+    "__adddf3", "__subdf3", "__muldf3", "__divdf3",
+    "__floatsidf", "__floatunsidf", "__fixdfsi", "__fixunsdfsi",
+    "__eqdf2", "__nedf2", "__ltdf2", "__ledf2", "__gtdf2", "__gedf2",
+    "__addsf3", "__subsf3", "__mulsf3", "__divsf3", "__extendsfdf2", "__truncdfsf2",
+)
+MULTIPLIES = {"mult", "multu"}
+DIVIDES = {"div", "divu"}
+# a line of execlog output: cpu, pc, opcode, "disassembly", then any memory accesses
+EXECLOG_LINE = re.compile(r'^\s*\d+,\s*0x([0-9a-fA-F]+),\s*0x[0-9a-fA-F]+,\s*"([^"]*)"')
+
+
+def helper_addresses(nm, binary):
+    """Maps the entry addresses of the helpers linked into binary to their names."""
+    output = subprocess.run([*shlex.split(nm), binary], check=True, capture_output=True, text=True).stdout
+    addresses = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[2] in HELPERS:
+            addresses[int(fields[0], 16)] = fields[2]
+    return addresses
+
+
+def count_log(log, helpers):
+    """Counts the instructions, multiplies, divides and helper calls in an execlog log."""
+    counts = {"instructions": 0, "multiplies": 0, "divides": 0, "helper_calls": {}}
+    for line in log:
+        match = EXECLOG_LINE.match(line)
+        if match is None:
+            continue
+        counts["instructions"] += 1
+        mnemonic = match.group(2).split(" ", 1)[0]
+        if mnemonic in MULTIPLIES:
+            counts["multiplies"] += 1
+        elif mnemonic in DIVIDES:
+            counts["divides"] += 1
+        helper = helpers.get(int(match.group(1), 16))
+        if helper is not None:
+            counts["helper_calls"][helper] = counts["helper_calls"].get(helper, 0) + 1
+    return counts
+
+
+def run(arguments, helpers, operation, iterations):
+    """Runs operation for the given number of iterations under the emulator and counts what it executed."""
+    with tempfile.TemporaryDirectory() as directory:
+        log_path = os.path.join(directory, "execlog.txt")
+        subprocess.run(
+            [
+                *shlex.split(arguments.emulator),
+                "-plugin", arguments.plugin, "-d", "plugin", "-D", log_path,
+                arguments.binary, operation, str(iterations),
+            ],
+            check=True,
+        )
+        with open(log_path) as log:
+            return count_log(log, helpers)
+
+
+def per_iteration(arguments, helpers, operation):
+    """The counts for one iteration of operation, including the loop calling it."""
+    once = run(arguments, helpers, operation, arguments.iterations)
+    twice = run(arguments, helpers, operation, 2 * arguments.iterations)
+    result = {
+        key: (twice[key] - once[key]) / arguments.iterations
+        for key in ("instructions", "multiplies", "divides")
+    }
+    result["helper_calls"] = {
+        helper: (calls - once["helper_calls"].get(helper, 0)) / arguments.iterations
+        for helper, calls in twice["helper_calls"].items()
+    }
+    return result
+
+
+def measure(arguments):
+    """The counts for one iteration of every operation, less those of the loop calling them."""
+    helpers = helper_addresses(arguments.nm, arguments.binary)
+    operations = subprocess.run(
+        [*shlex.split(arguments.emulator), arguments.binary, "--list"],
+        check=True, capture_output=True, text=True,
+    ).stdout.split()
+    baseline = per_iteration(arguments, helpers, "baseline")
+    results = {}
+    for operation in operations:
+        if operation == "baseline":
+            continue
+        counts = per_iteration(arguments, helpers, operation)
+        for key in ("instructions", "multiplies", "divides"):
+            counts[key] -= baseline[key]
+        counts["helper_calls"] = {helper: calls for helper, calls in counts["helper_calls"].items() if calls > 0}
+        counts["cycles"] = (
+            counts["instructions"]
+            + counts["multiplies"] * (arguments.mult_cycles - 1)
+            + counts["divides"] * (arguments.div_cycles - 1)
+        )
+        results[operation] = counts
+    return results
+
+
+def format_table(results, previous):
+    """A Markdown table of the results, with the change in cycles from previous if given."""
+    header = ["operation", "instructions", "mult", "div", "est. cycles", "helper calls"]
+    if previous is not None:
+        header.append("change in cycles")
+    rows = [header, ["---"] * len(header)]
+    for operation, counts in results.items():
+        helpers = ", ".join(f"{helper} ×{calls:g}" for helper, calls in sorted(counts["helper_calls"].items()))
+        row = [
+            operation,
+            f"{counts['instructions']:.1f}",
+            f"{counts['multiplies']:g}",
+            f"{counts['divides']:g}",
+            f"{counts['cycles']:.1f}",
+            helpers or "-",
+        ]
+        if previous is not None:
+            if operation in previous:
+                old = previous[operation]["cycles"]
+                change = counts["cycles"] - old
+                row.append(f"{change:+.1f} ({change / old:+.0%})" if old else f"{change:+.1f}")
+            else:
+                row.append("new")
+        rows.append(row)
+    return "\n".join("| " + " | ".join(row) + " |" for row in rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Count the MIPS instructions each PSXFixed operation takes")
+    parser.add_argument("--binary", required=True, help="instruction-counts program built for little-endian MIPS")
+    parser.add_argument("--plugin", required=True, help="path to qemu's libexeclog.so plugin")
+    parser.add_argument("--emulator", default="qemu-mipsel", help="qemu user-mode emulator command")
+    parser.add_argument("--nm", default="mipsel-linux-gnu-nm", help="nm command for the binary")
+    parser.add_argument("--iterations", type=int, default=64, help="iterations of each operation to count")
+    parser.add_argument("--mult-cycles", type=int, default=13, help="cycles taken by MULT/MULTU")
+    parser.add_argument("--div-cycles", type=int, default=36, help="cycles taken by DIV/DIVU")
+    parser.add_argument("--json", help="write the results to this JSON file")
+    parser.add_argument("--compare", help="JSON results of another version to compare with")
+    arguments = parser.parse_args()
+
+    results = measure(arguments)
+    previous = None
+    if arguments.compare is not None:
+        with open(arguments.compare) as file:
+            previous = json.load(file)["operations"]
+    print(format_table(results, previous))
+    if arguments.json is not None:
+        with open(arguments.json, "w") as file:
+            json.dump(
+                {
+                    "mult_cycles": arguments.mult_cycles,
+                    "div_cycles": arguments.div_cycles,
+                    "operations": results,
+                },
+                file,
+                indent=4,
+            )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,55 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef COM_SAXBOPHONE_UNMOVING_BENCHMARKS_VALUES_HPP
+#define COM_SAXBOPHONE_UNMOVING_BENCHMARKS_VALUES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <unmoving/PSXFixed.hpp>
+
+namespace benchmarks {
+    // a power of two, so that stepping through the values is only a mask
+    constexpr std::size_t COUNT = 1'024;
+
+    /*
+     * inputs are taken in turn from arrays of random values, so that every
+     * iteration does one operation on values the compiler can't predict
+     */
+    template <typename T>
+    using Values = std::array<T, COUNT>;
+
+    // random PSXFixed values with raw values in the range [min, max], different for each seed
+    inline Values<unmoving::PSXFixed> random_values(unsigned seed, std::int32_t min, std::int32_t max) {
+        std::mt19937 engine(seed);
+        std::uniform_int_distribution<std::int32_t> distribution(min, max);
+        Values<unmoving::PSXFixed> values;
+        for (auto& value : values) {
+            value = distribution(engine);
+        }
+        return values;
+    }
+
+    // values whose products and quotients mostly fit in PSXFixed
+    inline Values<unmoving::PSXFixed> small_values(unsigned seed) {
+        Values<unmoving::PSXFixed> values = random_values(seed, -0x100000, 0x100000);
+        // never divide by zero
+        for (auto& value : values) {
+            if (value == 0) { value = 1; }
+        }
+        return values;
+    }
+}
+
+#endif // include guard
@@ -0,0 +1,28 @@
+# Cross-compiles for the PlayStation's CPU (a MIPS R3000, which is little-endian
+# MIPS I) as Linux programs, so that they can be run under qemu user-mode
+# emulation, for counting instructions with ENABLE_BENCHMARKS
+#
+# Usage: cmake .. -DCMAKE_TOOLCHAIN_FILE=../cmake/Toolchains/mipsel-r3000.cmake -DCMAKE_BUILD_TYPE=Release -DENABLE_BENCHMARKS=ON
+#
+# NOTE: the C library of a mipsel-linux-gnu toolchain uses hard-float, so
+# floating-point conversions run as FPU instructions rather than calls into
+# soft-float helpers as on the PlayStation, and their counts are lower bounds
+set(CMAKE_SYSTEM_NAME Linux)
+set(CMAKE_SYSTEM_PROCESSOR mipsel)
+
+set(UNMOVING_MIPS_PREFIX "mipsel-linux-gnu-" CACHE STRING "Prefix of the MIPS cross-compiler's tools")
+set(CMAKE_CXX_COMPILER "${UNMOVING_MIPS_PREFIX}g++")
+set(CMAKE_NM "${UNMOVING_MIPS_PREFIX}nm" CACHE FILEPATH "")
+# for ENABLE_CODEGEN_CHECKS, which is on by default with this toolchain
+set(CMAKE_OBJDUMP "${UNMOVING_MIPS_PREFIX}objdump" CACHE FILEPATH "")
+
+set(CMAKE_CXX_FLAGS_INIT "-march=r3000 -mabi=32")
+# static, so that qemu doesn't need a MIPS sysroot to find the shared libraries
+set(CMAKE_EXE_LINKER_FLAGS_INIT "-static")
+
+set(CMAKE_CROSSCOMPILING_EMULATOR "qemu-mipsel" CACHE STRING "Emulator used to run the MIPS programs")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE ONLY)
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+This script forms part of Unmoving
+
+Checks what the PSXFixed operations compile to, by disassembling the object
+file built from operators.cpp and looking at each codegen_* function, along
+with any functions from the same object file that it calls.
+
+It fails if any of them call a forbidden function (the libgcc helpers for
+64-bit and soft-float arithmetic, which are slow on the PlayStation, or the
+printf() family), or if any of them take more instructions than the budget
+recorded for the target in budgets.json. Budgets are recorded with --record.
+
+Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+"""
+import argparse
+import json
+import re
+import shlex
+import subprocess
+import sys
+
+PREFIX = "codegen_"
+FORBIDDEN = {
+    # 64-bit integer arithmetic
+    "__muldi3", "__divdi3", "__udivdi3", "__moddi3", "__umoddi3", "__divmoddi4", "__udivmoddi4",
+    "__ashldi3", "__ashrdi3", "__lshrdi3",
+    # soft-float arithmetic
+    "__adddf3", "__subdf3", "__muldf3", "__divdf3", "__negdf2",
+    "__floatsidf", "__floatunsidf", "__floatdidf", "__fixdfsi", "__fixunsdfsi", "__fixdfdi",
+    "__eqdf2", "__nedf2", "__ltdf2", "__ledf2", "__gtdf2", "__gedf2", "__unorddf2",
+    "__addsf3", "__subsf3", "__mulsf3", "__divsf3", "__extendsfdf2", "__truncdfsf2",
+    # formatted output
+    "printf", "sprintf", "snprintf", "vsprintf", "vsnprintf", "__sprintf_chk", "__snprintf_chk",
+}
+# "0000000000000000 <name>:"
+FUNCTION = re.compile(r"^[0-9a-fA-F]+ <(.+)>:$")
+# "\t\t\t5: R_X86_64_PLT32\t__muldi3-0x4"
+RELOCATION = re.compile(r"^\s+[0-9a-fA-F]+: R_\S+\s+([^\s+-]+)")
+# "   4:\tcall   10 <name+0x4>"
+INSTRUCTION = re.compile(r"^\s+[0-9a-fA-F]+:\t")
+REFERENCE = re.compile(r"<([^>+]+)(?:\+0x[0-9a-fA-F]+)?>")
+
+
+def plain(symbol):
+    """symbol without the leading underscore added on some platforms, such as macOS."""
+    unprefixed = symbol[1:]
+    if symbol.startswith("_") and (unprefixed.startswith(PREFIX) or unprefixed in FORBIDDEN):
+        return unprefixed
+    return symbol
+
+
+def disassemble(objdump, objects):
+    """Maps each function in objects to its instruction count and the symbols it refers to."""
+    functions = {}
+    current = None
+    for path in objects:
+        output = subprocess.run(
+            [*shlex.split(objdump), "-dr", "--no-show-raw-insn", path],
+            check=True, capture_output=True, text=True,
+        ).stdout
+        for line in output.splitlines():
+            match = FUNCTION.match(line)
+            if match is not None:
+                current = functions.setdefault(plain(match.group(1)), {"instructions": 0, "references": set()})
+                continue
+            if current is None:
+                continue
+            match = RELOCATION.match(line)
+            if match is not None:
+                # with a section per function, calls may refer to the section rather than the function
+                symbol = match.group(1)
+                current["references"].add(plain(symbol[len(".text."):] if symbol.startswith(".text.") else symbol))
+            elif INSTRUCTION.match(line):
+                current["instructions"] += 1
+                current["references"].update(plain(symbol) for symbol in REFERENCE.findall(line))
+    return functions
+
+
+def check(functions, name):
+    """The instructions of name and everything it calls in the object, and the forbidden functions called."""
+    seen = set()
+    pending = [name]
+    instructions = 0
+    forbidden = set()
+    while pending:
+        function = pending.pop()
+        if function in seen:
+            continue
+        seen.add(function)
+        if function in FORBIDDEN:
+            forbidden.add(function)
+        if function not in functions:
+            continue
+        instructions += functions[function]["instructions"]
+        pending.extend(functions[function]["references"])
+    return instructions, forbidden
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check the generated code of the PSXFixed operations")
+    parser.add_argument("--objdump", default="objdump", help="objdump command for the object files")
+    parser.add_argument("--budgets", required=True, help="JSON file of instruction budgets")
+    parser.add_argument("--target", required=True, help="name of the budgets to use, e.g. mipsel-GNU-10")
+    parser.add_argument("--record", action="store_true", help="record the current counts as the budgets")
+    parser.add_argument("--stamp", help="file to write when the checks pass")
+    parser.add_argument("objects", nargs="+", help="object files built from operators.cpp")
+    arguments = parser.parse_args()
+
+    functions = disassemble(arguments.objdump, arguments.objects)
+    results = {
+        name[len(PREFIX):]: check(functions, name)
+        for name in sorted(functions) if name.startswith(PREFIX)
+    }
+    with open(arguments.budgets) as file:
+        budgets = json.load(file)
+
+    if arguments.record:
+        budgets[arguments.target] = {operation: instructions for operation, (instructions, _) in results.items()}
+        with open(arguments.budgets, "w") as file:
+            json.dump(budgets, file, indent=4, sort_keys=True)
+            file.write("\n")
+        print(f"Recorded budgets for {arguments.target} in {arguments.budgets}")
+        return 0
+
+    target_budgets = budgets.get(arguments.target)
+    if target_budgets is None:
+        print(f"No budgets recorded for {arguments.target}, only checking for forbidden calls")
+        target_budgets = {}
+    failed = False
+    for operation, (instructions, forbidden) in results.items():
+        budget = target_budgets.get(operation)
+        problems = []
+        if forbidden:
+            problems.append("calls " + ", ".join(sorted(forbidden)))
+        if budget is not None and instructions > budget:
+            problems.append(f"over budget of {budget} instructions")
+        failed = failed or bool(problems)
+        print(
+            f"{operation:<20} {instructions:>5} instructions"
+            + (f" (budget {budget})" if budget is not None else "")
+            + ("  FAILED: " + "; ".join(problems) if problems else "")
+        )
+    if failed:
+        return 1
+    if arguments.stamp is not None:
+        with open(arguments.stamp, "w"):
+            pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,43 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * Each PSXFixed operation wrapped in a function with C linkage, so that
+ * check_codegen.py can find them by name in the disassembly of this file and
+ * check what they compile to. Raw values are passed in and out, so that the
+ * wrappers add as little code as possible around the operations.
+ */
+#include <unmoving/PSXFixed.hpp>
+
+using namespace unmoving;
+
+using Raw = PSXFixed::UnderlyingType;
+
+extern "C" {
+    Raw codegen_add(Raw lhs, Raw rhs) { return PSXFixed(lhs) + PSXFixed(rhs); }
+    Raw codegen_subtract(Raw lhs, Raw rhs) { return PSXFixed(lhs) - PSXFixed(rhs); }
+    Raw codegen_multiply(Raw lhs, Raw rhs) { return PSXFixed(lhs) * PSXFixed(rhs); }
+    Raw codegen_divide(Raw lhs, Raw rhs) { return PSXFixed(lhs) / PSXFixed(rhs); }
+    Raw codegen_multiply_integer(Raw lhs, Raw rhs) { return PSXFixed(lhs) * rhs; }
+    Raw codegen_divide_integer(Raw lhs, Raw rhs) { return PSXFixed(lhs) / rhs; }
+    Raw codegen_negate(Raw value) { return -PSXFixed(value); }
+    bool codegen_less(Raw lhs, Raw rhs) { return PSXFixed(lhs) < PSXFixed(rhs); }
+    Raw codegen_from_integer(int value) { return PSXFixed::from_integer(value); }
+    Raw codegen_to_integer(Raw value) { return PSXFixed(value).to_integer(); }
+    bool codegen_to_c_str(Raw value, char* buffer, size_t buffer_size) { return PSXFixed(value).to_c_str(buffer, buffer_size); }
+    char* codegen_to_chars(Raw value, char* first, char* last) { return PSXFixed(value).to_chars(first, last).ptr; }
+    const char* codegen_from_chars(const char* first, const char* last, Raw* value) {
+        PSXFixed parsed;
+        FromCharsResult result = PSXFixed::from_chars(first, last, parsed);
+        *value = parsed;
+        return result.ptr;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+#include "int128.hpp"
+
+using namespace unmoving;
+
+TEMPLATE_TEST_CASE(
+    "Accumulator sums full products and rounds once",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<8, 8, std::uint16_t>), (Fixed<16, 16, std::uint32_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    using Limits = std::numeric_limits<U>;
+    // exact sum of the raw products, which is wide enough even for those of unsigned 32-bit integers
+    using Exact = Int128;
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    // signed sums of products close to the limits don't fit in the 64 bits accumulated in
+    std::int64_t limit = sizeof(U) == 4 and std::is_signed_v<U> ? 1 << 30 : Limits::max();
+    std::uniform_int_distribution<std::int64_t> distribution(std::is_signed_v<U> ? -limit : 0, limit);
+    U raws[6] = {};
+    for (auto& raw : raws) {
+        raw = (U)distribution(engine);
+    }
+    typename TestType::Accumulator accumulator;
+    Exact exact = 0;
+    for (std::size_t i = 0; i < 6; i += 2) {
+        accumulator.mac(TestType(raws[i]), TestType(raws[i + 1]));
+        exact += (Exact)raws[i] * raws[i + 1];
+    }
+    // division of a signed integer rounds towards zero, then wraps to the storage type
+    U expected = (U)(exact / TestType::SCALE);
+    CHECK(accumulator.result() == TestType(expected));
+    CHECK((TestType)accumulator == TestType(expected));
+
+    SECTION("Adding and subtracting values") {
+        accumulator += TestType(raws[0]);
+        accumulator -= TestType(raws[1]);
+        exact += (Exact)raws[0] * TestType::SCALE;
+        exact -= (Exact)raws[1] * TestType::SCALE;
+        CHECK(accumulator.result() == TestType((U)(exact / TestType::SCALE)));
+    }
+}
+
+TEST_CASE("Accumulator gives the exact sum of products rounded towards zero") {
+    double a = GENERATE(take(tests_config::ITERATIONS, random(-400.0, 400.0)));
+    double b = GENERATE(take(1, random(-400.0, 400.0)));
+    double c = GENERATE(take(1, random(-400.0, 400.0)));
+    PSXFixed x(a), y(b), z(c);
+    // exact, as the products of PSXFixed values fit in the mantissa of double
+    double exact = (double)x * (double)y + (double)y * (double)z + (double)z * (double)x;
+
+    PSXFixed accumulated = PSXFixed::Accumulator().mac(x, y).mac(y, z).mac(z, x).result();
+    CHECK((double)accumulated == std::trunc(exact * PSXFixed::SCALE) / PSXFixed::SCALE);
+    // rounded once, so the error is less than one step, unlike when summing rounded products
+    CHECK(std::abs((double)accumulated - exact) < PSXFixed::PRECISION);
+}
+
+TEST_CASE("Accumulator can be used at compile-time") {
+    STATIC_REQUIRE(PSXFixed::Accumulator().mac(1.5_fx, 2.0_fx).mac(-0.25_fx, 4.0_fx).result() == 2.0_fx);
+    STATIC_REQUIRE(PSXFixed16::Accumulator().mac(PSXFixed16(7.5), PSXFixed16(7.5)).result() == PSXFixed16(56.25 - 64.0));
+}
@@ -0,0 +1,205 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/batch.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+// not a multiple of any vector width, so that the scalar loop for the leftovers gets used too
+static constexpr std::size_t COUNT = 1'003;
+
+// raw values which are most likely to be handled differently by the vector kernels
+static const std::int32_t EDGES[] = {
+    0, 1, -1, 2, -2, 4095, -4095, 4096, -4096, 4097, -4097, 65535, -65536,
+    std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min(),
+    std::numeric_limits<std::int32_t>::max() - 1, std::numeric_limits<std::int32_t>::min() + 1,
+};
+
+static std::vector<PSXFixed> random_values(std::mt19937& engine, std::int32_t min, std::int32_t max) {
+    std::uniform_int_distribution<std::int32_t> distribution(min, max);
+    std::vector<PSXFixed> values(COUNT);
+    for (auto& value : values) {
+        value = distribution(engine);
+    }
+    // scatter the edge cases through the values so that they end up in every lane
+    for (std::size_t i = 0; i < std::size(EDGES); i++) {
+        values[i * 7 % COUNT] = EDGES[i];
+        values[(i * 13 + 5) % COUNT] = EDGES[std::size(EDGES) - 1 - i];
+    }
+    return values;
+}
+
+TEST_CASE("Batch arithmetic is bit-identical to the PSXFixed operators") {
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS / 1'000, random(0u, 0xFFFFFFFFu))));
+    // small values too, so that multiplication and division don't always overflow
+    std::int32_t range = GENERATE(std::numeric_limits<std::int32_t>::max(), 0x100000, 0x1000);
+    std::vector<PSXFixed> lhs = random_values(engine, -range, range);
+    std::vector<PSXFixed> rhs = random_values(engine, -range, range);
+    std::vector<PSXFixed> out(COUNT);
+
+    SECTION("add()") {
+        batch::add(lhs.data(), rhs.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == lhs[i] + rhs[i]);
+        }
+    }
+    SECTION("sub()") {
+        batch::sub(lhs.data(), rhs.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == lhs[i] - rhs[i]);
+        }
+    }
+    SECTION("mul()") {
+        batch::mul(lhs.data(), rhs.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == lhs[i] * rhs[i]);
+        }
+    }
+    SECTION("div()") {
+        for (auto& divisor : rhs) {
+            if (divisor == 0) { divisor = 1; }
+        }
+        batch::div(lhs.data(), rhs.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == lhs[i] / rhs[i]);
+        }
+    }
+    SECTION("scale()") {
+        PSXFixed factor = rhs[0];
+        batch::scale(lhs.data(), factor, out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == lhs[i] * factor);
+        }
+    }
+    SECTION("output can be the same array as an input") {
+        std::vector<PSXFixed> expected(COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            if (rhs[i] == 0) { rhs[i] = 1; }
+            expected[i] = lhs[i] / rhs[i];
+        }
+        batch::div(lhs.data(), rhs.data(), rhs.data(), COUNT);
+        REQUIRE(rhs == expected);
+    }
+}
+
+TEST_CASE("Batch conversions are bit-identical to the PSXFixed conversions") {
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS / 1'000, random(0u, 0xFFFFFFFFu))));
+
+    SECTION("from_double()") {
+        std::uniform_real_distribution<double> distribution(PSXFixed::FRACTIONAL_MIN, PSXFixed::FRACTIONAL_MAX);
+        std::vector<double> in(COUNT);
+        for (auto& value : in) {
+            value = distribution(engine);
+        }
+        // values which are exactly halfway between two PSXFixed values, or close to zero
+        std::uniform_int_distribution<std::int32_t> raw(-0x1000, 0x1000);
+        for (std::size_t i = 0; i < COUNT; i += 3) {
+            in[i] = (raw(engine) + 0.5) / PSXFixed::SCALE;
+        }
+        std::vector<PSXFixed> out(COUNT);
+        batch::from_double(in.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == PSXFixed(in[i]));
+        }
+    }
+    SECTION("from_float()") {
+        std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+        std::vector<float> in(COUNT);
+        for (auto& value : in) {
+            value = distribution(engine);
+        }
+        std::vector<PSXFixed> out(COUNT);
+        batch::from_float(in.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == PSXFixed((double)in[i]));
+        }
+    }
+    SECTION("from_float_bits()") {
+        std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+        std::vector<std::uint32_t> in(COUNT);
+        for (auto& bits : in) {
+            bits = std::bit_cast<std::uint32_t>(distribution(engine));
+        }
+        std::vector<PSXFixed> out(COUNT);
+        batch::from_float_bits(in.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == PSXFixed((double)std::bit_cast<float>(in[i])));
+        }
+    }
+    SECTION("from_double_bits()") {
+        std::uniform_real_distribution<double> distribution(PSXFixed::FRACTIONAL_MIN, PSXFixed::FRACTIONAL_MAX);
+        std::vector<std::uint64_t> in(COUNT);
+        for (auto& bits : in) {
+            bits = std::bit_cast<std::uint64_t>(distribution(engine));
+        }
+        std::vector<PSXFixed> out(COUNT);
+        batch::from_double_bits(in.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == PSXFixed(std::bit_cast<double>(in[i])));
+        }
+    }
+    SECTION("to_double()") {
+        std::vector<PSXFixed> in = random_values(engine, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max());
+        std::vector<double> out(COUNT);
+        batch::to_double(in.data(), out.data(), COUNT);
+        for (std::size_t i = 0; i < COUNT; i++) {
+            REQUIRE(out[i] == (double)in[i]);
+        }
+    }
+}
+
+TEST_CASE("Batch parsing of lists of values") {
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS / 1'000, random(0u, 0xFFFFFFFFu))));
+    std::vector<PSXFixed> values = random_values(engine, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max());
+    // values written with every kind of separator between them
+    const char* separators[] = {" ", ",", ", ", "\n", "\t,\r\n"};
+    std::string text = " ";
+    for (std::size_t i = 0; i < COUNT; i++) {
+        char buffer[16] = {};
+        text.append(buffer, values[i].to_shortest_chars(buffer, buffer + sizeof(buffer)).ptr);
+        text += separators[i % std::size(separators)];
+    }
+    std::vector<PSXFixed> out(COUNT);
+
+    SECTION("All of the values are parsed") {
+        batch::FromCharsResult result = batch::from_chars(text.data(), text.data() + text.size(), out.data(), COUNT);
+        CHECK(result.error == FromCharsError::NONE);
+        CHECK(result.count == COUNT);
+        CHECK(result.ptr == text.data() + text.size());
+        REQUIRE(out == values);
+    }
+    SECTION("Parsing stops when the output is full") {
+        batch::FromCharsResult result = batch::from_chars(text.data(), text.data() + text.size(), out.data(), 10);
+        CHECK(result.error == FromCharsError::NONE);
+        CHECK(result.count == 10);
+        CHECK(std::equal(out.begin(), out.begin() + 10, values.begin()));
+    }
+    SECTION("Parsing stops at the first value which can't be parsed") {
+        std::size_t position = text.find(',', text.size() / 2);
+        text.insert(position, "x");
+        batch::FromCharsResult result = batch::from_chars(text.data(), text.data() + text.size(), out.data(), COUNT);
+        CHECK(result.error == FromCharsError::INVALID);
+        CHECK(result.ptr == text.data() + position);
+        CHECK(std::equal(out.begin(), out.begin() + (std::ptrdiff_t)result.count, values.begin()));
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstdint>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+TEST_CASE("PSXFixed16 is half the size of PSXFixed") {
+    STATIC_REQUIRE(sizeof(PSXFixed16) == sizeof(std::int16_t));
+    STATIC_REQUIRE(sizeof(PSXFixed16[64]) * 2 == sizeof(PSXFixed[64]));
+    STATIC_REQUIRE(PSXFixed16::FRACTION_BITS == PSXFixed::FRACTION_BITS);
+    STATIC_REQUIRE(PSXFixed16::SCALE == PSXFixed::SCALE);
+}
+
+TEST_CASE("PSXFixed16 widens to PSXFixed without changing value") {
+    std::int16_t raw = GENERATE(take(tests_config::ITERATIONS, random(INT16_MIN, INT16_MAX)));
+    PSXFixed16 compact = raw;
+    PSXFixed wide = compact; // implicit
+
+    CHECK((PSXFixed::UnderlyingType)wide == raw);
+    CHECK((double)wide == (double)compact);
+    // widening and narrowing again round-trips
+    CHECK(PSXFixed16(wide) == compact);
+    CHECK(PSXFixed16::saturate(wide) == compact);
+}
+
+TEST_CASE("PSXFixed16::saturate() clamps values which are out of range") {
+    std::int32_t raw = GENERATE(take(tests_config::ITERATIONS, random(INT32_MIN, INT32_MAX)));
+    PSXFixed wide = raw;
+    PSXFixed16 compact = PSXFixed16::saturate(wide);
+
+    if (raw > INT16_MAX) {
+        CHECK(compact == PSXFixed16::MAX());
+    } else if (raw < INT16_MIN) {
+        CHECK(compact == PSXFixed16::MIN());
+    } else {
+        CHECK((PSXFixed16::UnderlyingType)compact == raw);
+    }
+}
+
+TEST_CASE("PSXFixed16::saturate() from formats with more fraction bits truncates towards zero") {
+    using Wide = Fixed<15, 16, std::int32_t>;
+    std::int32_t raw = GENERATE(take(tests_config::ITERATIONS, random(INT32_MIN, INT32_MAX)));
+    Wide wide = raw;
+    PSXFixed16 compact = PSXFixed16::saturate(wide);
+
+    // the exact value truncated to 12 fraction bits, as a raw value
+    std::int64_t truncated = raw / 16;
+    if (truncated > INT16_MAX) {
+        CHECK(compact == PSXFixed16::MAX());
+    } else if (truncated < INT16_MIN) {
+        CHECK(compact == PSXFixed16::MIN());
+    } else {
+        CHECK((PSXFixed16::UnderlyingType)compact == truncated);
+    }
+}
+
+TEST_CASE("PSXFixed16 saturates to zero when narrowed to an unsigned format") {
+    using Unsigned = Fixed<4, 12, std::uint16_t>;
+    CHECK(Unsigned::saturate(PSXFixed16(-1.0)) == Unsigned::MIN());
+    CHECK(Unsigned::saturate(PSXFixed16(7.5)) == Unsigned(7.5));
+    CHECK(PSXFixed16::saturate(Unsigned::MAX()) == PSXFixed16::MAX());
+}
+
+TEST_CASE("PSXFixed16 arithmetic can be mixed with PSXFixed once widened") {
+    PSXFixed16 compact = PSXFixed16(1.5);
+    PSXFixed wide = 100.25_fx;
+
+    // the result is a PSXFixed, which doesn't overflow
+    STATIC_REQUIRE(std::is_same_v<decltype(PSXFixed(compact) * wide), PSXFixed>);
+    CHECK(PSXFixed(compact) * wide == 150.375_fx);
+    CHECK(wide / PSXFixed(compact) == wide / 1.5_fx);
+    CHECK(PSXFixed(compact) + wide == 101.75_fx);
+}
+
+TEST_CASE("PSXFixed16 can be saturated at compile-time") {
+    STATIC_REQUIRE(PSXFixed16::saturate(123.45_fx) == PSXFixed16::MAX());
+    STATIC_REQUIRE(PSXFixed16::saturate(-123.45_fx) == PSXFixed16::MIN());
+    STATIC_REQUIRE(PSXFixed16::saturate(1.25_fx) == PSXFixed16(1.25));
+}
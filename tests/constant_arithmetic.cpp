@@ -0,0 +1,96 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <limits>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+using Underlying = PSXFixed::UnderlyingType;
+
+// some values from the edges of the range, which are checked against every constant
+static constexpr Underlying EDGES[] = {
+    std::numeric_limits<Underlying>::min(),
+    std::numeric_limits<Underlying>::min() + 1,
+    -4097, -4096, -4095, -1, 0, 1, 4095, 4096, 4097,
+    std::numeric_limits<Underlying>::max() - 1,
+    std::numeric_limits<Underlying>::max(),
+};
+
+template <Underlying CONSTANT>
+static void check_integer_constant(Underlying i) {
+    CAPTURE(i, CONSTANT);
+    if constexpr (CONSTANT != 0) {
+        // integer division overflows for this one case
+        if (not (i == std::numeric_limits<Underlying>::min() and CONSTANT == -1)) {
+            REQUIRE(PSXFixed(i).div_by<CONSTANT>() == PSXFixed(i) / CONSTANT);
+        }
+    }
+    REQUIRE(PSXFixed(i).mul_by<CONSTANT>() == PSXFixed((Underlying)((std::uint32_t)i * (std::uint32_t)CONSTANT)));
+}
+
+template <Underlying CONSTANT>
+static void check_fixed_constant(Underlying i) {
+    CAPTURE(i, CONSTANT);
+    if constexpr (CONSTANT != 0) {
+        REQUIRE(PSXFixed(i).div_by<PSXFixed(CONSTANT)>() == PSXFixed(i) / PSXFixed(CONSTANT));
+    }
+    REQUIRE(PSXFixed(i).mul_by<PSXFixed(CONSTANT)>() == PSXFixed(i) * PSXFixed(CONSTANT));
+}
+
+template <Underlying OFFSET, Underlying STRIDE, Underlying... INDICES>
+static void check_constants(Underlying i, std::integer_sequence<Underlying, INDICES...>) {
+    (check_integer_constant<OFFSET + INDICES * STRIDE>(i), ...);
+    (check_fixed_constant<OFFSET + INDICES * STRIDE>(i), ...);
+}
+
+template <Underlying OFFSET, Underlying STRIDE, Underlying COUNT>
+static void check_constants() {
+    Underlying i = GENERATE(
+        take(
+            tests_config::ITERATIONS / 100,
+            random(
+                std::numeric_limits<Underlying>::min(),
+                std::numeric_limits<Underlying>::max()
+            )
+        )
+    );
+    check_constants<OFFSET, STRIDE>(i, std::make_integer_sequence<Underlying, COUNT>{});
+    for (Underlying edge : EDGES) {
+        check_constants<OFFSET, STRIDE>(edge, std::make_integer_sequence<Underlying, COUNT>{});
+    }
+}
+
+TEST_CASE("Arithmetic with compile-time constants matches the generic operators") {
+    SECTION("Small constants") {
+        check_constants<-128, 1, 257>();
+    }
+
+    SECTION("Constants around PSXFixed::SCALE") {
+        check_constants<4096 - 64, 1, 129>();
+    }
+
+    SECTION("Large constants") {
+        check_constants<-1'000'000'000, 7'812'501, 257>();
+    }
+}
+
+TEST_CASE("Arithmetic with compile-time constants can be evaluated at compile-time") {
+    STATIC_REQUIRE(6.0_fx .div_by<3>() == 2.0_fx);
+    STATIC_REQUIRE(3.0_fx .div_by<1.5_fx>() == 2.0_fx);
+    STATIC_REQUIRE(3.0_fx .mul_by<-2>() == -6.0_fx);
+    STATIC_REQUIRE(3.0_fx .mul_by<0.5_fx>() == 1.5_fx);
+}
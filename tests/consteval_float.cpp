@@ -0,0 +1,39 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * NOTE: this file is only compiled, to check that all of the library can be
+ * used with UNMOVING_CONSTEVAL_FLOAT, which would violate the one-definition
+ * rule if it were linked into the test executable. consteval_float_failure.cpp
+ * checks that it does indeed stop floating point being used at runtime.
+ */
+#define UNMOVING_CONSTEVAL_FLOAT 1
+
+#include <unmoving/PSXFixed.hpp>
+#include <unmoving/PSXFixed16x2.hpp>
+#include <unmoving/batch.hpp>
+#include <unmoving/counting.hpp>
+#include <unmoving/exponential.hpp>
+#include <unmoving/roots.hpp>
+#include <unmoving/trigonometry.hpp>
+
+using namespace unmoving;
+
+// conversions from floating point can still be done at compile-time
+static_assert(PSXFixed(1.5) == 1.5_fx);
+static_assert((double)1.5_fx == 1.5);
+static_assert((float)PSXFixed16(0.25) == 0.25f);
+
+PSXFixed consteval_float_check(PSXFixed x, int numerator, int denominator) {
+    PSXFixed ratio = PSXFixed::from_ratio(numerator, denominator);
+    PSXFixed converted = PSXFixed::from_float_bits((unsigned)numerator);
+    return unmoving::sqrt(x) + unmoving::sin(x) + unmoving::exp2(x) + ratio * converted + PSXFixed(0.5);
+}
@@ -0,0 +1,24 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * NOTE: this file must fail to compile, as it converts a double to PSXFixed at
+ * runtime with UNMOVING_CONSTEVAL_FLOAT
+ */
+#define UNMOVING_CONSTEVAL_FLOAT 1
+
+#include <unmoving/PSXFixed.hpp>
+
+using namespace unmoving;
+
+PSXFixed consteval_float_failure(double value) {
+    return PSXFixed(value);
+}
@@ -124,3 +124,39 @@ TEST_CASE("Constructors") {
     }
 }
 
+TEMPLATE_TEST_CASE(
+    "Creation from ratio of integers",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    int numerator = GENERATE(take(tests_config::ITERATIONS, random(std::numeric_limits<int>::min(), std::numeric_limits<int>::max())));
+    // small denominators too, so that not all of the results are tiny
+    int denominator = GENERATE(take(1, random(std::numeric_limits<int>::min(), std::numeric_limits<int>::max())), take(1, random(-100, 100)));
+    if (denominator == 0) { denominator = 1; }
+    CAPTURE(numerator, denominator);
+    // exact, rounded to nearest with ties away from zero
+    long double scaled = (long double)numerator * TestType::SCALE / denominator;
+    long double expected = std::round(scaled);
+    long double lowest = std::numeric_limits<U>::min(), highest = std::numeric_limits<U>::max();
+    if (expected < lowest) {
+        REQUIRE(TestType::from_ratio(numerator, denominator) == TestType::MIN());
+    } else if (expected > highest) {
+        REQUIRE(TestType::from_ratio(numerator, denominator) == TestType::MAX());
+    } else {
+        REQUIRE(TestType::from_ratio(numerator, denominator) == TestType((U)expected));
+    }
+}
+
+TEST_CASE("Creation from ratio of integers is exact and can be done at compile-time") {
+    STATIC_REQUIRE(PSXFixed::from_ratio(3, 2) == 1.5_fx);
+    STATIC_REQUIRE(PSXFixed::from_ratio(-3, 4) == -0.75_fx);
+    STATIC_REQUIRE(PSXFixed::from_ratio(1, -8192) == PSXFixed(-1));
+    STATIC_REQUIRE(PSXFixed::from_ratio(1, 3) == 0.333333333333333333_fx);
+    STATIC_REQUIRE(PSXFixed::from_ratio(-2, 3) == -0.666666666666666666_fx);
+    STATIC_REQUIRE(PSXFixed::from_ratio(524287, 1) == 524287_fx);
+    STATIC_REQUIRE(PSXFixed::from_ratio(524288, 1) == PSXFixed::MAX());
+    STATIC_REQUIRE(PSXFixed::from_ratio(-524288, 1) == PSXFixed::MIN());
+    STATIC_REQUIRE(PSXFixed::from_ratio(1, 0) == PSXFixed::MAX());
+    STATIC_REQUIRE(PSXFixed::from_ratio(-1, 0) == PSXFixed::MIN());
+}
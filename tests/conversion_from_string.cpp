@@ -0,0 +1,168 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+#include "int128.hpp"
+
+using namespace unmoving;
+
+// the raw value nearest to sign whole.digits (ties away from zero), or false if out of range
+template <typename T>
+static bool exact_reference(bool negative, std::uint64_t whole, const std::string& digits, typename T::UnderlyingType& raw) {
+    using U = typename T::UnderlyingType;
+    // scaled, the numerator is less than 2**116 for the formats and lengths tested
+    Int128 numerator = whole, denominator = 1;
+    for (char digit : digits) {
+        numerator = numerator * 10 + (Int128)(digit - '0');
+        denominator *= 10;
+    }
+    Int128 scaled = numerator << T::FRACTION_BITS;
+    Int128 magnitude = scaled / denominator + (2 * (scaled % denominator) >= denominator ? 1 : 0);
+    Int128 limit = negative ? (Int128)(0 - (std::int64_t)std::numeric_limits<U>::min()) : (Int128)std::numeric_limits<U>::max();
+    if (magnitude > limit) { return false; }
+    raw = (U)(negative ? 0 - (std::int64_t)magnitude : (std::int64_t)magnitude);
+    return true;
+}
+
+TEMPLATE_TEST_CASE(
+    "from_chars() parses decimals exactly",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>), (Fixed<8, 8, std::uint16_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    bool negative = std::uniform_int_distribution<int>(0, 1)(engine) == 1;
+    // slightly past the whole part of the limits, to check the edges
+    std::uint64_t whole = std::uniform_int_distribution<std::uint64_t>(0, ((std::uint64_t)std::numeric_limits<U>::max() >> TestType::FRACTION_BITS) + 1)(engine);
+    std::string digits(std::uniform_int_distribution<std::size_t>(0, 25)(engine), '0');
+    for (char& digit : digits) {
+        digit = (char)('0' + std::uniform_int_distribution<int>(0, 9)(engine));
+    }
+    std::string text = (negative ? "-" : "") + std::to_string(whole) + (digits.empty() ? "" : "." + digits) + " rest";
+    CAPTURE(text);
+    TestType value(TestType::MAX());
+    FromCharsResult result = TestType::from_chars(text.data(), text.data() + text.size(), value);
+    CHECK(result.ptr == text.data() + text.size() - 5);
+    U expected = 0;
+    if (exact_reference<TestType>(negative, whole, digits, expected)) {
+        REQUIRE(result.error == FromCharsError::NONE);
+        CHECK(value == TestType(expected));
+    } else {
+        REQUIRE(result.error == FromCharsError::OUT_OF_RANGE);
+        // left alone
+        CHECK(value == TestType::MAX());
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "from_chars() reads back what to_chars() and to_shortest_chars() write",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>), (Fixed<8, 8, std::uint16_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    U raw = GENERATE(
+        take(tests_config::ITERATIONS, random(std::numeric_limits<U>::min(), std::numeric_limits<U>::max())),
+        std::numeric_limits<U>::min(),
+        std::numeric_limits<U>::max()
+    );
+    TestType value(raw);
+    char output[64] = {};
+    ToCharsResult written = value.to_shortest_chars(output, output + sizeof(output));
+    TestType parsed;
+    FromCharsResult result = TestType::from_chars(output, written.ptr, parsed);
+    CHECK(result.error == FromCharsError::NONE);
+    CHECK(result.ptr == written.ptr);
+    CHECK(parsed == value);
+    // every digit of the exact value
+    written = value.to_chars(output, output + sizeof(output), TestType::FRACTION_BITS);
+    result = TestType::from_chars(output, written.ptr, parsed);
+    CHECK(result.ptr == written.ptr);
+    CHECK(parsed == value);
+}
+
+TEST_CASE("from_chars() finds the end of the number") {
+    auto text = GENERATE(table<std::string, std::size_t, PSXFixed>({
+        {"1.5", 3, 1.5_fx},
+        {"-1.5", 4, -1.5_fx},
+        {"+1.5", 4, 1.5_fx},
+        {"2.", 2, 2_fx},
+        {".25", 3, 0.25_fx},
+        {"-.25", 4, -0.25_fx},
+        {"007", 3, 7_fx},
+        {"1e5", 1, 1_fx},
+        {"1.5.5", 3, 1.5_fx},
+        {"3,4", 1, 3_fx},
+        {"0.000122070312499999999999999999", 32, 0_fx},
+        {"0.0001220703125", 15, PSXFixed(1)},
+        {"-524288", 7, PSXFixed::MIN()},
+        {"524287.999755859375", 19, PSXFixed::MAX()},
+    }));
+    std::string string = std::get<0>(text);
+    CAPTURE(string);
+    PSXFixed value;
+    FromCharsResult result = PSXFixed::from_chars(string.data(), string.data() + string.size(), value);
+    CHECK(result.error == FromCharsError::NONE);
+    CHECK(result.ptr == string.data() + std::get<1>(text));
+    CHECK(value == std::get<2>(text));
+}
+
+TEST_CASE("from_chars() reports errors") {
+    SECTION("No number") {
+        std::string string = GENERATE("", "-", "+", ".", "-.", " 1", "x", "e5", "--1");
+        CAPTURE(string);
+        PSXFixed value = 1_fx;
+        FromCharsResult result = PSXFixed::from_chars(string.data(), string.data() + string.size(), value);
+        CHECK(result.error == FromCharsError::INVALID);
+        CHECK(result.ptr == string.data());
+        CHECK(value == 1_fx);
+    }
+    SECTION("Out of range") {
+        std::string string = GENERATE("524288", "-524288.0002", "524287.99987792969", "99999999999999999999.5", "-1000000");
+        CAPTURE(string);
+        PSXFixed value = 1_fx;
+        FromCharsResult result = PSXFixed::from_chars(string.data(), string.data() + string.size(), value);
+        CHECK(result.error == FromCharsError::OUT_OF_RANGE);
+        CHECK(result.ptr == string.data() + string.size());
+        CHECK(value == 1_fx);
+    }
+    SECTION("Negative values in unsigned formats") {
+        using Unsigned = Fixed<16, 16, std::uint32_t>;
+        Unsigned value;
+        std::string string = "-1";
+        CHECK(Unsigned::from_chars(string.data(), string.data() + 2, value).error == FromCharsError::OUT_OF_RANGE);
+        string = "-0.000001";
+        CHECK(Unsigned::from_chars(string.data(), string.data() + string.size(), value).error == FromCharsError::NONE);
+        CHECK(value == Unsigned());
+    }
+}
+
+// from_chars() of a string at compile-time
+template <std::size_t N>
+static constexpr PSXFixed parse(const char (&text)[N]) {
+    PSXFixed value;
+    PSXFixed::from_chars(text, text + N - 1, value);
+    return value;
+}
+
+TEST_CASE("from_chars() can be used at compile-time") {
+    STATIC_REQUIRE(parse("123.456") == 123.456_fx);
+    STATIC_REQUIRE(parse("-0.1") == -0.1_fx);
+    STATIC_REQUIRE(parse("42") == 42_fx);
+}
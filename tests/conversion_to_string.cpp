@@ -11,13 +11,17 @@
  */
  #include <limits>
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <string>
 
 #include <catch2/catch.hpp>
 
 #include <unmoving/PSXFixed.hpp>
 
 #include "config.hpp"
+#include "int128.hpp"
 
 using namespace unmoving;
 
@@ -62,3 +66,206 @@ TEST_CASE("Conversion to String") {
         REQUIRE_FALSE(var.to_c_str(output, buffer_size));
     }
 }
+
+// how to_c_str() used to be written, with snprintf()
+template <typename T>
+static std::string snprintf_reference(T value) {
+    using U = typename T::UnderlyingType;
+    U raw = value;
+    std::int64_t whole = (std::int64_t)raw / T::SCALE;
+    std::uint64_t magnitude = raw < 0 ? 0 - (std::uint64_t)(std::int64_t)raw : (std::uint64_t)raw;
+    unsigned fraction = (unsigned)((magnitude % (std::uint64_t)T::SCALE) * 1'000'000 >> T::FRACTION_BITS);
+    char buffer[32] = {};
+    std::snprintf(buffer, sizeof(buffer), "%s%lld.%06u", raw < 0 and whole == 0 ? "-" : "", (long long)whole, fraction);
+    return buffer;
+}
+
+TEMPLATE_TEST_CASE(
+    "to_chars() writes the same characters as snprintf()",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>), (Fixed<8, 8, std::uint16_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    U raw = GENERATE(
+        take(tests_config::ITERATIONS, random(std::numeric_limits<U>::min(), std::numeric_limits<U>::max())),
+        std::numeric_limits<U>::min(),
+        std::numeric_limits<U>::max(),
+        (U)0,
+        (U)1
+    );
+    TestType value(raw);
+    std::string expected = snprintf_reference(value);
+    char output[32] = {};
+    ToCharsResult result = value.to_chars(output, output + sizeof(output));
+    REQUIRE(result.success);
+    CHECK(std::string(output, result.ptr) == expected);
+
+    SECTION("A range one character too small is left alone") {
+        char small[32] = {};
+        ToCharsResult failure = value.to_chars(small, small + expected.size() - 1);
+        CHECK_FALSE(failure.success);
+        CHECK(failure.ptr == small + expected.size() - 1);
+        CHECK(std::string(small) == "");
+    }
+    SECTION("A range exactly big enough is filled") {
+        char exact[32] = {};
+        CHECK(value.to_chars(exact, exact + expected.size()).ptr == exact + expected.size());
+        CHECK(std::string(exact) == expected);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "to_chars() with a precision writes the same characters as snprintf()",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>), (Fixed<8, 8, std::uint16_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    U raw = GENERATE(
+        take(tests_config::ITERATIONS, random(std::numeric_limits<U>::min(), std::numeric_limits<U>::max())),
+        // values which are exactly halfway between two decimals, and which round up into the whole part
+        (U)(TestType::SCALE / 2),
+        (U)(TestType::SCALE / 2 + TestType::SCALE),
+        (U)(TestType::SCALE - 1),
+        std::numeric_limits<U>::min(),
+        std::numeric_limits<U>::max(),
+        (U)0
+    );
+    TestType value(raw);
+    int precision = GENERATE(0, 1, 2, 3, 5, 8, 12, 20, 35);
+    CAPTURE(raw, precision);
+    // printf() rounds exactly, with ties to even
+    char expected[64] = {};
+    int length = std::snprintf(expected, sizeof(expected), "%.*f", precision, (double)value);
+    char output[64] = {};
+    ToCharsResult result = value.to_chars(output, output + sizeof(output), (std::size_t)precision);
+    REQUIRE(result.success);
+    CHECK(std::string(output, result.ptr) == expected);
+    CHECK_FALSE(value.to_chars(output, output + length - 1, (std::size_t)precision).success);
+}
+
+// whether the decimal number whole.digits converts back to the magnitude raw
+template <typename T>
+static bool round_trips(std::uint32_t raw, std::uint64_t whole, std::uint64_t digits, std::size_t count) {
+    Int128 power = 1;
+    for (std::size_t i = 0; i < count; i++) { power *= 10; }
+    // whole.digits * 2**(FRACTION_BITS + 1) must be within [2 * raw - 1, 2 * raw + 1) * 10**count
+    Int128 scaled = ((Int128)whole * power + digits) << (T::FRACTION_BITS + 1);
+    return scaled >= (2 * (Int128)raw - 1) * power and scaled < (2 * (Int128)raw + 1) * power;
+}
+
+// the nearest shortest decimal number which converts back to magnitude raw, found by trial and error
+template <typename T>
+static std::string shortest_reference(T value) {
+    using U = typename T::UnderlyingType;
+    U raw = value;
+    std::uint32_t magnitude = raw < 0 ? 0u - (std::uint32_t)raw : (std::uint32_t)raw;
+    std::string sign = raw < 0 ? "-" : "";
+    for (std::size_t count = 0; ; count++) {
+        std::uint64_t power = 1;
+        for (std::size_t i = 0; i < count; i++) { power *= 10; }
+        // the candidates either side of the value (the product is less than 2**96)
+        Int128 exact = (Int128)magnitude * power;
+        std::uint64_t below = (std::uint64_t)(exact >> T::FRACTION_BITS), above = below + 1;
+        bool below_ok = round_trips<T>(magnitude, below / power, below % power, count);
+        bool above_ok = round_trips<T>(magnitude, above / power, above % power, count);
+        if (below_ok or above_ok) {
+            // the nearer one, going away from zero if they're just as near
+            Int128 below_distance = exact - ((Int128)below << T::FRACTION_BITS);
+            Int128 above_distance = ((Int128)above << T::FRACTION_BITS) - exact;
+            std::uint64_t chosen = below_ok and (not above_ok or below_distance < above_distance) ? below : above;
+            std::string digits = std::to_string(chosen % power);
+            std::string whole = std::to_string(chosen / power);
+            if (count == 0) { return sign + whole; }
+            return sign + whole + "." + std::string(count - digits.size(), '0') + digits;
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "to_shortest_chars() writes the shortest decimal which converts back to the same value",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>), (Fixed<8, 8, std::uint16_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    U raw = GENERATE(
+        take(tests_config::ITERATIONS, random(std::numeric_limits<U>::min(), std::numeric_limits<U>::max())),
+        std::numeric_limits<U>::min(),
+        std::numeric_limits<U>::max(),
+        (U)0,
+        (U)1,
+        (U)(TestType::SCALE - 1)
+    );
+    TestType value(raw);
+    CAPTURE(raw);
+    std::string expected = shortest_reference(value);
+    char output[64] = {};
+    ToCharsResult result = value.to_shortest_chars(output, output + sizeof(output));
+    REQUIRE(result.success);
+    CHECK(std::string(output, result.ptr) == expected);
+    CHECK_FALSE(value.to_shortest_chars(output, output + expected.size() - 1).success);
+}
+
+TEST_CASE("to_shortest_chars() writes the shortest decimal for every PSXFixed16") {
+    for (std::int32_t raw = -32768; raw <= 32767; raw++) {
+        PSXFixed16 value((std::int16_t)raw);
+        char output[16] = {};
+        ToCharsResult result = value.to_shortest_chars(output, output + sizeof(output));
+        REQUIRE(std::string(output, result.ptr) == shortest_reference(value));
+    }
+}
+
+// to_chars() of value at compile-time, for comparing with an expected string
+template <std::size_t N>
+static constexpr bool writes(PSXFixed value, const char (&expected)[N]) {
+    char output[16] = {};
+    ToCharsResult result = value.to_chars(output, output + sizeof(output));
+    if (not result.success or result.ptr != output + N - 1) { return false; }
+    for (std::size_t i = 0; i < N - 1; i++) {
+        if (output[i] != expected[i]) { return false; }
+    }
+    return true;
+}
+
+// to_chars() of value with a precision at compile-time
+template <std::size_t N>
+static constexpr bool writes(PSXFixed value, std::size_t precision, const char (&expected)[N]) {
+    char output[16] = {};
+    ToCharsResult result = value.to_chars(output, output + sizeof(output), precision);
+    if (not result.success or result.ptr != output + N - 1) { return false; }
+    for (std::size_t i = 0; i < N - 1; i++) {
+        if (output[i] != expected[i]) { return false; }
+    }
+    return true;
+}
+
+// to_shortest_chars() of value at compile-time
+template <std::size_t N>
+static constexpr bool writes_shortest(PSXFixed value, const char (&expected)[N]) {
+    char output[16] = {};
+    ToCharsResult result = value.to_shortest_chars(output, output + sizeof(output));
+    if (not result.success or result.ptr != output + N - 1) { return false; }
+    for (std::size_t i = 0; i < N - 1; i++) {
+        if (output[i] != expected[i]) { return false; }
+    }
+    return true;
+}
+
+TEST_CASE("to_chars() can be used at compile-time") {
+    STATIC_REQUIRE(writes(0_fx, "0.000000"));
+    STATIC_REQUIRE(writes(1.5_fx, "1.500000"));
+    STATIC_REQUIRE(writes(-0.25_fx, "-0.250000"));
+    STATIC_REQUIRE(writes(PSXFixed(1), "0.000244"));
+    STATIC_REQUIRE(writes(PSXFixed::MAX(), "524287.999755"));
+    STATIC_REQUIRE(writes(PSXFixed::MIN(), "-524288.000000"));
+    STATIC_REQUIRE(writes(1.005_fx, 2, "1.00"));
+    STATIC_REQUIRE(writes(0.5_fx, 0, "0"));
+    STATIC_REQUIRE(writes(1.5_fx, 0, "2"));
+    STATIC_REQUIRE(writes(-9.9999_fx, 3, "-10.000"));
+    STATIC_REQUIRE(writes(PSXFixed(1), 12, "0.000244140625"));
+    STATIC_REQUIRE(writes_shortest(0_fx, "0"));
+    STATIC_REQUIRE(writes_shortest(3_fx, "3"));
+    STATIC_REQUIRE(writes_shortest(0.1_fx, "0.1"));
+    STATIC_REQUIRE(writes_shortest(-123.456_fx, "-123.456"));
+    STATIC_REQUIRE(writes_shortest(PSXFixed(1), "0.0002"));
+    STATIC_REQUIRE(writes_shortest(PSXFixed::MAX(), "524287.9998"));
+}
@@ -0,0 +1,203 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * NOTE: counting_disabled.cpp checks that counting compiles out to nothing,
+ * which would violate the one-definition rule if it were linked in here
+ */
+#define UNMOVING_COUNT_OPERATIONS 1
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/counting.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+TEST_CASE("Counted gives the same results as the type it wraps") {
+    std::int32_t i = GENERATE(take(tests_config::ITERATIONS, random(-0x1000000, 0x1000000)));
+    std::int32_t j = GENERATE(take(1, filter([](std::int32_t u) { return u != 0; }, random(-0x1000000, 0x1000000))));
+    PSXFixed x(i), y(j);
+    CountedPSXFixed a(i), b(j);
+    CHECK(a + b == x + y);
+    CHECK(a - b == x - y);
+    CHECK(a * b == x * y);
+    CHECK(a / b == x / y);
+    CHECK(a * 3 == x * 3);
+    CHECK(3 * a == 3 * x);
+    CHECK(a / 3 == x / 3);
+    CHECK(-a == -x);
+    CHECK(a.to_integer() == x.to_integer());
+    CHECK((double)a == (double)x);
+    // mixed with the type it wraps
+    CHECK(a + y == x + y);
+    CHECK(x * b == x * y);
+    // the fused and constant arithmetic
+    CHECK(a.fast_div(b) == x.fast_div(y));
+    CHECK(a * b.reciprocal() == x * y.reciprocal());
+    CHECK(CountedPSXFixed::mul_div(a, b, b) == PSXFixed::mul_div(x, y, y));
+    CHECK(CountedPSXFixed::mul_shift(a, b, 4) == PSXFixed::mul_shift(x, y, 4));
+    CHECK(a.div_by<3>() == x.div_by<3>());
+    CHECK(a.mul_by<0.5_fx>() == x.mul_by<0.5_fx>());
+    CHECK(CountedPSXFixed::from_ratio(i, j) == PSXFixed::from_ratio(i, j));
+    CHECK(CountedPSXFixed::Accumulator().mac(a, b).mac(b, a).result() == PSXFixed::Accumulator().mac(x, y).mac(y, x).result());
+}
+
+TEST_CASE("Counted counts each kind of operation") {
+    CountingScope scope;
+    CountedPSXFixed a = 1.5_fx, b = 2.25_fx;
+    a = a + b;
+    a -= b;
+    a = -a;
+    ++a;
+    a--;
+    CHECK(scope.counts()[CountedOperation::ADDITION] == 5);
+    a = a * b;
+    a *= 2;
+    a = 3 * a;
+    CHECK(scope.counts()[CountedOperation::MULTIPLICATION] == 3);
+    a = a / b;
+    a /= 2;
+    CHECK(scope.counts()[CountedOperation::DIVISION] == 2);
+    a = CountedPSXFixed(0.75);
+    a = CountedPSXFixed::from_integer(3);
+    CHECK(a.to_integer() == 3);
+    CHECK((double)a == 3.0);
+    CHECK((float)a == 3.0f);
+    CHECK(scope.counts()[CountedOperation::CONVERSION] == 5);
+    char buffer[16] = {};
+    CHECK(a.to_c_str(buffer, sizeof(buffer)));
+    a.to_chars(buffer, buffer + sizeof(buffer));
+    a.to_chars(buffer, buffer + sizeof(buffer), 2);
+    ToCharsResult written = a.to_shortest_chars(buffer, buffer + sizeof(buffer));
+    CHECK(CountedPSXFixed::from_chars(buffer, written.ptr, b).error == FromCharsError::NONE);
+    CHECK(b == a);
+    CHECK(scope.counts()[CountedOperation::FORMATTING] == 5);
+    // the rest don't count anything
+    CHECK(a > b - 1_fx);
+    CountedPSXFixed c = a;
+    c = 1.0_fx;
+    CHECK(scope.counts()[CountedOperation::ADDITION] == 6);
+}
+
+TEST_CASE("Counted counts fused and constant arithmetic") {
+    CountingScope scope;
+    CountedPSXFixed a = 1.5_fx, b = 2.25_fx;
+    PSXFixed::Reciprocal reciprocal = b.reciprocal();
+    a = a * reciprocal;
+    a = reciprocal * a;
+    CHECK(scope.counts()[CountedOperation::DIVISION] == 1);
+    CHECK(scope.counts()[CountedOperation::MULTIPLICATION] == 2);
+    a = a.fast_div(b);
+    a = CountedPSXFixed::mul_div(a, b, b);
+    a = CountedPSXFixed::from_ratio(1, 3);
+    CHECK(scope.counts()[CountedOperation::DIVISION] == 4);
+    CHECK(scope.counts()[CountedOperation::MULTIPLICATION] == 4);
+    a = CountedPSXFixed::mul_shift(a, b, 2);
+    a = a.div_by<3>();
+    a = a.mul_by<3>();
+    CHECK(scope.counts()[CountedOperation::MULTIPLICATION] == 7);
+    CountedPSXFixed::Accumulator sum;
+    sum.mac(a, b).mac(b, a);
+    sum += a;
+    sum -= b;
+    a = sum.result();
+    CHECK(scope.counts()[CountedOperation::MULTIPLICATION] == 9);
+    CHECK(scope.counts()[CountedOperation::ADDITION] == 2);
+    a = CountedPSXFixed::from_float_bits(0x3FC00000);
+    a = CountedPSXFixed::from_double_bits(0x3FF8000000000000);
+    CHECK(a == 1.5_fx);
+    CHECK(scope.counts()[CountedOperation::CONVERSION] == 2);
+}
+
+TEST_CASE("CountingScopes nest") {
+    CountedPSXFixed a = 2.0_fx;
+    // nothing is counted, but nothing goes wrong either, without a scope
+    a = a * a;
+    CountingScope frame;
+    a = a * a;
+    {
+        CountingScope inner;
+        a = a / 2;
+        a = a / 2;
+        CHECK(inner.counts()[CountedOperation::DIVISION] == 2);
+        CHECK(inner.counts()[CountedOperation::MULTIPLICATION] == 0);
+        CHECK(frame.counts()[CountedOperation::DIVISION] == 0);
+    }
+    // the inner scope's counts are added to the outer one when it ends
+    CHECK(frame.counts()[CountedOperation::DIVISION] == 2);
+    CHECK(frame.counts()[CountedOperation::MULTIPLICATION] == 1);
+    a = a + a;
+    CHECK(frame.counts()[CountedOperation::ADDITION] == 1);
+
+    SECTION("Each thread has its own scopes") {
+        std::thread([] {
+            CountedPSXFixed b = 1.0_fx;
+            b = b / 3;
+        }).join();
+        CHECK(frame.counts()[CountedOperation::DIVISION] == 2);
+    }
+}
+
+TEST_CASE("CountingScope estimates cycles") {
+    CountingScope scope;
+    CountedPSXFixed a = 3.0_fx;
+    for (int i = 0; i < 10; i++) {
+        a = a * 1.5_fx + 1.0_fx;
+    }
+    a = a / 7;
+    CycleTable table = {{1, 10, 50, 100, 1'000}, 100'000};
+    CHECK(scope.estimated_cycles(table) == 10 * 1 + 10 * 10 + 50);
+    CycleTable r3000 = CycleTable::R3000();
+    CHECK(scope.estimated_cycles() == 10 * r3000[CountedOperation::ADDITION] + 10 * r3000[CountedOperation::MULTIPLICATION] + r3000[CountedOperation::DIVISION]);
+
+    SECTION("Report") {
+        char buffer[400] = {};
+        REQUIRE(scope.report(buffer, sizeof(buffer), table));
+        CHECK(
+            std::string(buffer) ==
+            "additions: 10 x 1 = 10 cycles\n"
+            "multiplications: 10 x 10 = 100 cycles\n"
+            "divisions: 1 x 50 = 50 cycles\n"
+            "conversions: 0 x 100 = 0 cycles\n"
+            "formatting: 0 x 1000 = 0 cycles\n"
+            "total: 160 cycles, 0.16% of a frame\n"
+        );
+        // only the null-terminator doesn't fit
+        std::size_t length = std::string(buffer).size();
+        CHECK_FALSE(scope.report(buffer, length, table));
+        CHECK(buffer[0] == '\0');
+        CHECK(scope.report(buffer, length + 1, table));
+    }
+    SECTION("The largest report fits in 400 characters") {
+        OperationCounts counts;
+        CycleTable largest = {{}, 1};
+        for (std::size_t i = 0; i < COUNTED_OPERATION_KINDS; i++) {
+            counts.counts[i] = std::numeric_limits<std::uint32_t>::max();
+            largest.cycles[i] = std::numeric_limits<std::uint32_t>::max();
+        }
+        // saturated
+        CHECK(counts.estimated_cycles(largest) == std::numeric_limits<std::uint32_t>::max());
+        char buffer[400] = {};
+        CHECK(counts.report(buffer, sizeof(buffer), largest));
+        // too much of a frame to show what share of it
+        CHECK(std::string(buffer).ends_with("total: 4294967295 cycles\n"));
+        largest.frame_cycles = 0xFFFFFF;
+        CHECK(counts.report(buffer, sizeof(buffer), largest));
+        CHECK(std::string(buffer).ends_with("total: 4294967295 cycles, 25600.00% of a frame\n"));
+    }
+}
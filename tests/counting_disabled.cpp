@@ -0,0 +1,34 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * NOTE: this file is only compiled, to check that counting compiles out to
+ * nothing when UNMOVING_COUNT_OPERATIONS is 0, which would violate the
+ * one-definition rule if it were linked into the test executable alongside
+ * counting.cpp
+ */
+#include <type_traits>
+
+#include <unmoving/counting.hpp>
+
+using namespace unmoving;
+
+static_assert(std::is_same_v<CountedPSXFixed, PSXFixed>);
+static_assert(std::is_same_v<Counted<PSXFixed16>, PSXFixed16>);
+static_assert(std::is_empty_v<CountingScope>);
+static_assert(CountingScope().estimated_cycles() == 0);
+static_assert(CountingScope().counts()[CountedOperation::DIVISION] == 0);
+
+PSXFixed counting_disabled_check(CountedPSXFixed x, CountedPSXFixed y) {
+    CountingScope scope;
+    CountingScope::count(CountedOperation::DIVISION);
+    return x * y / 2;
+}
@@ -9,7 +9,9 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
- #include <catch2/catch.hpp>
+#include <limits>
+
+#include <catch2/catch.hpp>
 
 #include <unmoving/PSXFixed.hpp>
 
@@ -100,3 +102,83 @@ TEST_CASE("Division") {
         }
     }
 }
+
+TEST_CASE("32-bit-only division matches 64-bit division") {
+    SECTION("Over the full operand range") {
+        Underlying i = GENERATE(
+            take(
+                tests_config::ITERATIONS,
+                random(
+                    std::numeric_limits<Underlying>::min(),
+                    std::numeric_limits<Underlying>::max()
+                )
+            )
+        );
+        Underlying j = GENERATE(
+            take(
+                8,
+                filter(
+                    [](Underlying u) { return u != 0; },
+                    random(
+                        std::numeric_limits<Underlying>::min(),
+                        std::numeric_limits<Underlying>::max()
+                    )
+                )
+            )
+        );
+        CAPTURE(i, j);
+        REQUIRE(
+            detail::divide_shift_narrow(i, j, PSXFixed::FRACTION_BITS) ==
+            detail::divide_shift_wide(i, j, PSXFixed::FRACTION_BITS)
+        );
+    }
+
+    SECTION("With small divisors") {
+        Underlying i = GENERATE(
+            take(
+                tests_config::ITERATIONS,
+                random(
+                    std::numeric_limits<Underlying>::min(),
+                    std::numeric_limits<Underlying>::max()
+                )
+            )
+        );
+        // small divisors exercise the path where the remainder is scaled with a native division
+        Underlying j = GENERATE(
+            take(
+                8,
+                filter(
+                    [](Underlying u) { return u != 0; },
+                    random(-1048576, 1048576)
+                )
+            )
+        );
+        CAPTURE(i, j);
+        REQUIRE(
+            detail::divide_shift_narrow(i, j, PSXFixed::FRACTION_BITS) ==
+            detail::divide_shift_wide(i, j, PSXFixed::FRACTION_BITS)
+        );
+    }
+
+    SECTION("At the edges of the operand range") {
+        Underlying i = GENERATE(
+            std::numeric_limits<Underlying>::min(),
+            std::numeric_limits<Underlying>::min() + 1,
+            -4097, -4096, -4095, -1, 0, 1, 4095, 4096, 4097,
+            std::numeric_limits<Underlying>::max() - 1,
+            std::numeric_limits<Underlying>::max()
+        );
+        Underlying j = GENERATE(
+            std::numeric_limits<Underlying>::min(),
+            std::numeric_limits<Underlying>::min() + 1,
+            -4097, -4096, -4095, -1, 1, 4095, 4096, 4097,
+            std::numeric_limits<Underlying>::max() - 1,
+            std::numeric_limits<Underlying>::max()
+        );
+        CAPTURE(i, j);
+        REQUIRE(
+            detail::divide_shift_narrow(i, j, PSXFixed::FRACTION_BITS) ==
+            detail::divide_shift_wide(i, j, PSXFixed::FRACTION_BITS)
+        );
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/exponential.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+// the largest value of PSXFixed, beyond which results saturate
+static constexpr double LARGEST = PSXFixed::FRACTIONAL_MAX;
+
+// error of result from exact, in steps
+static double error_of(PSXFixed result, double exact) {
+    return std::abs((double)result - exact) * PSXFixed::SCALE;
+}
+
+// the accuracy tables in the documentation of exponential.hpp
+TEST_CASE("exp2() and exp() are accurate for every exponent with a result in range") {
+    // every exponent there is, between where the results round to zero and where they saturate
+    for (std::int32_t raw = -14 * 4096; raw < 20 * 4096; raw++) {
+        double x = (double)PSXFixed(raw);
+        CAPTURE(raw, x);
+        double power_of_two = std::exp2(x);
+        if (power_of_two < LARGEST) {
+            REQUIRE(error_of(unmoving::exp2(PSXFixed(raw)), power_of_two) <= 0.5 + std::ldexp(power_of_two, 12 - 28));
+        } else {
+            REQUIRE(unmoving::exp2(PSXFixed(raw)) == PSXFixed::MAX());
+        }
+        double power_of_e = std::exp(x);
+        if (power_of_e < LARGEST) {
+            REQUIRE(error_of(unmoving::exp(PSXFixed(raw)), power_of_e) <= 0.5 + std::ldexp(power_of_e, 12 - 27));
+        } else {
+            REQUIRE(unmoving::exp(PSXFixed(raw)) == PSXFixed::MAX());
+        }
+    }
+}
+
+TEST_CASE("exp2() and exp() of exponents far out of range") {
+    std::int32_t raw = GENERATE(take(tests_config::ITERATIONS, random(20 * 4096, 0x7FFFFFFF)));
+    CHECK(unmoving::exp2(PSXFixed(raw)) == PSXFixed::MAX());
+    CHECK(unmoving::exp(PSXFixed(raw)) == PSXFixed::MAX());
+    CHECK(unmoving::exp2(PSXFixed(-raw)) == 0_fx);
+    CHECK(unmoving::exp(PSXFixed(-raw)) == 0_fx);
+}
+
+TEST_CASE("log2() and log() are accurate") {
+    std::int32_t raw = GENERATE(
+        take(tests_config::ITERATIONS, random(1, 0x7FFFFFFF)),
+        // values less than one, whose logarithms are negative
+        take(tests_config::ITERATIONS, random(1, 4096)),
+        0x7FFFFFFF
+    );
+    double x = (double)PSXFixed(raw);
+    CAPTURE(raw, x);
+    CHECK(error_of(unmoving::log2(PSXFixed(raw)), std::log2(x)) <= 0.5 + std::ldexp(1.0, 12 - 25));
+    CHECK(error_of(unmoving::log(PSXFixed(raw)), std::log(x)) <= 0.5 + std::ldexp(1.0, 12 - 25));
+}
+
+TEST_CASE("log2() and log() of values with no logarithm") {
+    std::int32_t raw = GENERATE(take(tests_config::ITERATIONS, random(-0x7FFFFFFF - 1, 0)));
+    CHECK(unmoving::log2(PSXFixed(raw)) == PSXFixed::MIN());
+    CHECK(unmoving::log(PSXFixed(raw)) == PSXFixed::MIN());
+}
+
+TEST_CASE("pow() is accurate") {
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    // bases of all sizes, and exponents which keep some of the results in range
+    std::int32_t base = std::uniform_int_distribution<std::int32_t>(1, 0x7FFFFFFF >> GENERATE(0, 8, 16, 24))(engine);
+    std::int32_t exponent = std::uniform_int_distribution<std::int32_t>(-32 * 4096, 32 * 4096)(engine);
+    double x = (double)PSXFixed(base), y = (double)PSXFixed(exponent);
+    CAPTURE(x, y);
+    double exact = std::pow(x, y);
+    PSXFixed result = unmoving::pow(PSXFixed(base), PSXFixed(exponent));
+    if (exact < LARGEST) {
+        CHECK(error_of(result, exact) <= 0.5 + std::ldexp(exact, 12 - 25) * std::max(1.0, std::abs(y)));
+    } else {
+        CHECK(result == PSXFixed::MAX());
+    }
+}
+
+TEST_CASE("exponential functions are exact where the results are exact and can be used at compile-time") {
+    STATIC_REQUIRE(unmoving::exp2(0_fx) == 1_fx);
+    STATIC_REQUIRE(unmoving::exp2(10_fx) == 1024_fx);
+    STATIC_REQUIRE(unmoving::exp2(-3_fx) == 0.125_fx);
+    STATIC_REQUIRE(unmoving::exp2(-12_fx) == PSXFixed(1));
+    STATIC_REQUIRE(unmoving::exp(0_fx) == 1_fx);
+    STATIC_REQUIRE(unmoving::log2(1_fx) == 0_fx);
+    STATIC_REQUIRE(unmoving::log2(1024_fx) == 10_fx);
+    STATIC_REQUIRE(unmoving::log2(0.125_fx) == -3_fx);
+    STATIC_REQUIRE(unmoving::log(1_fx) == 0_fx);
+    STATIC_REQUIRE(unmoving::pow(2_fx, 10_fx) == 1024_fx);
+    STATIC_REQUIRE(unmoving::pow(4_fx, 0.5_fx) == 2_fx);
+    STATIC_REQUIRE(unmoving::pow(9_fx, -0.5_fx) == PSXFixed(1.0 / 3.0));
+    STATIC_REQUIRE(unmoving::pow(0_fx, 2_fx) == 0_fx);
+}
@@ -0,0 +1,125 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+// whether value rounds to a value in range, as the converting constructor from double wraps otherwise
+template <typename T>
+static bool constructible_from(double value) {
+    using U = typename T::UnderlyingType;
+    double scaled = value * T::SCALE;
+    return scaled > (double)(U)T::MIN() - 0.5 and scaled < (double)(U)T::MAX() + 0.5;
+}
+
+TEMPLATE_TEST_CASE(
+    "from_float_bits() and from_double_bits() round the same as the constructor from double",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    // values anywhere in range, those exactly halfway between two steps, and those near zero
+    std::int64_t raw = std::uniform_int_distribution<std::int64_t>(
+        std::numeric_limits<U>::min(),
+        std::numeric_limits<U>::max()
+    )(engine);
+    double near_zero = std::uniform_real_distribution<double>(-1.0, 1.0)(engine);
+    double offset = GENERATE(0.0, 0.5, -0.5, 0.25, 0.75);
+    double value = GENERATE_COPY(
+        ((double)raw + offset) / TestType::SCALE,
+        ((double)(raw % 4) + offset) / TestType::SCALE,
+        near_zero / TestType::SCALE
+    );
+    CAPTURE(value);
+    if (constructible_from<TestType>(value)) {
+        CHECK(TestType::from_double_bits(std::bit_cast<std::uint64_t>(value)) == TestType(value));
+    }
+    float single = (float)value;
+    if (constructible_from<TestType>((double)single)) {
+        CHECK(TestType::from_float_bits(std::bit_cast<std::uint32_t>(single)) == TestType((double)single));
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "from_float_bits() and from_double_bits() saturate values out of range",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<16, 16, std::uint32_t>), (Fixed<1, 30, std::int32_t>)
+) {
+    double value = GENERATE(
+        take(tests_config::ITERATIONS, random(1.0, 1e30)),
+        std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::infinity()
+    );
+    double too_large = (double)TestType::MAX() + value;
+    double too_small = (double)TestType::MIN() - value;
+    CAPTURE(too_large, too_small);
+    CHECK(TestType::from_double_bits(std::bit_cast<std::uint64_t>(too_large)) == TestType::MAX());
+    CHECK(TestType::from_double_bits(std::bit_cast<std::uint64_t>(too_small)) == TestType::MIN());
+    CHECK(TestType::from_float_bits(std::bit_cast<std::uint32_t>((float)too_large)) == TestType::MAX());
+    CHECK(TestType::from_float_bits(std::bit_cast<std::uint32_t>((float)too_small)) == TestType::MIN());
+}
+
+TEST_CASE("from_float_bits() and from_double_bits() of special values") {
+    SECTION("Zero and subnormals") {
+        double value = GENERATE(
+            0.0, -0.0,
+            std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::denorm_min(),
+            std::numeric_limits<double>::min(), -std::numeric_limits<double>::min()
+        );
+        CHECK(PSXFixed::from_double_bits(std::bit_cast<std::uint64_t>(value)) == 0_fx);
+        CHECK(PSXFixed::from_float_bits(std::bit_cast<std::uint32_t>((float)value)) == 0_fx);
+        float single = GENERATE(std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min());
+        CHECK(PSXFixed::from_float_bits(std::bit_cast<std::uint32_t>(single)) == 0_fx);
+        CHECK(PSXFixed::from_float_bits(std::bit_cast<std::uint32_t>(-single)) == 0_fx);
+    }
+    SECTION("NaN") {
+        double nan = GENERATE(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::signaling_NaN());
+        CHECK(PSXFixed::from_double_bits(std::bit_cast<std::uint64_t>(nan)) == 0_fx);
+        CHECK(PSXFixed::from_double_bits(std::bit_cast<std::uint64_t>(-nan)) == 0_fx);
+        CHECK(PSXFixed::from_float_bits(std::bit_cast<std::uint32_t>((float)nan)) == 0_fx);
+        CHECK(PSXFixed::from_float_bits(std::bit_cast<std::uint32_t>((float)-nan)) == 0_fx);
+    }
+    SECTION("Negative values in unsigned formats") {
+        using Unsigned = Fixed<16, 16, std::uint32_t>;
+        CHECK(Unsigned::from_double_bits(std::bit_cast<std::uint64_t>(-1.0)) == Unsigned::MIN());
+        CHECK(Unsigned::from_float_bits(std::bit_cast<std::uint32_t>(-1.0f)) == Unsigned::MIN());
+    }
+}
+
+TEST_CASE("from_float_bits() and from_double_bits() can be used at compile-time") {
+    STATIC_REQUIRE(PSXFixed::from_float_bits(0x3FC00000) == 1.5_fx);
+    STATIC_REQUIRE(PSXFixed::from_float_bits(0xC2F6E979) == PSXFixed(-123.456));
+    STATIC_REQUIRE(PSXFixed::from_double_bits(0x3FF8000000000000) == 1.5_fx);
+    STATIC_REQUIRE(PSXFixed::from_double_bits(0xC05EDD2F1A9FBE77) == PSXFixed(-123.456));
+    STATIC_REQUIRE(PSXFixed::from_float_bits(0x7F800000) == PSXFixed::MAX());
+    STATIC_REQUIRE(PSXFixed::from_float_bits(0xFF800000) == PSXFixed::MIN());
+}
+
+TEST_CASE("from_float_bits() rounds the same as the constructor from double for every float", "[.][exhaustive]") {
+    for (std::uint64_t bits = 0; bits <= 0xFFFFFFFF; bits++) {
+        float value = std::bit_cast<float>((std::uint32_t)bits);
+        if (not std::isnan(value) and constructible_from<PSXFixed>((double)value)) {
+            REQUIRE(PSXFixed::from_float_bits((std::uint32_t)bits) == PSXFixed((double)value));
+        }
+    }
+}
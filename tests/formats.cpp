@@ -0,0 +1,143 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+// a selection of formats other than PSXFixed, covering all the storage sizes and signedness
+#define FORMATS \
+    (Fixed<3, 4, std::int8_t>), \
+    (Fixed<3, 12, std::int16_t>), \
+    (Fixed<8, 8, std::uint16_t>), \
+    (Fixed<15, 16, std::int32_t>), \
+    (Fixed<16, 16, std::uint32_t>)
+
+// wraps an exact result to the storage type of Fixed, as its arithmetic operators do
+template <typename T>
+static T wrap(std::int64_t value) {
+    return T((typename T::UnderlyingType)(std::uint64_t)value);
+}
+
+template <typename T>
+static std::int64_t lowest() {
+    return std::numeric_limits<typename T::UnderlyingType>::min();
+}
+
+template <typename T>
+static std::int64_t highest() {
+    return std::numeric_limits<typename T::UnderlyingType>::max();
+}
+
+TEMPLATE_TEST_CASE("Fixed constants match its format", "", FORMATS) {
+    using U = typename TestType::UnderlyingType;
+    CHECK(TestType::SCALE == (U)(1u << TestType::FRACTION_BITS));
+    CHECK(TestType::PRECISION == 1.0 / TestType::SCALE);
+    CHECK(TestType::DECIMAL_MAX == highest<TestType>() / TestType::SCALE);
+    CHECK(TestType::DECIMAL_MIN == lowest<TestType>() / TestType::SCALE);
+    CHECK((U)TestType::MAX() == highest<TestType>());
+    CHECK((U)TestType::MIN() == lowest<TestType>());
+    CHECK((double)TestType::MAX() == TestType::FRACTIONAL_MAX);
+    CHECK((double)TestType::MIN() == TestType::FRACTIONAL_MIN);
+}
+
+TEMPLATE_TEST_CASE("Fixed arithmetic matches exact arithmetic", "", FORMATS) {
+    using U = typename TestType::UnderlyingType;
+    std::int64_t lhs = GENERATE(take(tests_config::ITERATIONS, random(lowest<TestType>(), highest<TestType>())));
+    std::int64_t rhs = GENERATE(take(1, random(lowest<TestType>(), highest<TestType>())));
+    TestType x((U)lhs), y((U)rhs);
+
+    SECTION("Addition") {
+        CHECK(x + y == wrap<TestType>(lhs + rhs));
+    }
+    SECTION("Subtraction") {
+        CHECK(x - y == wrap<TestType>(lhs - rhs));
+    }
+    SECTION("Multiplication") {
+        if constexpr (std::is_signed_v<U>) {
+            // division of a signed integer rounds towards zero
+            CHECK(x * y == wrap<TestType>((lhs * rhs) / TestType::SCALE));
+        } else {
+            // the product of two unsigned 32-bit integers doesn't fit in int64_t
+            CHECK(x * y == wrap<TestType>((std::int64_t)(((std::uint64_t)lhs * (std::uint64_t)rhs) >> TestType::FRACTION_BITS)));
+        }
+    }
+    SECTION("Division") {
+        if (rhs != 0) {
+            CHECK(x / y == wrap<TestType>((lhs * TestType::SCALE) / rhs));
+        }
+    }
+    SECTION("Arithmetic with constants") {
+        CHECK(x.template div_by<3>() == x / (U)3);
+        CHECK(x.template div_by<TestType(1.5)>() == x / TestType(1.5));
+        CHECK(x.template mul_by<5>() == x * (U)5);
+        CHECK(x.template mul_by<TestType(0.75)>() == x * TestType(0.75));
+    }
+}
+
+TEMPLATE_TEST_CASE("Fixed conversions", "", FORMATS) {
+    using U = typename TestType::UnderlyingType;
+    std::int64_t raw = GENERATE(take(tests_config::ITERATIONS, random(lowest<TestType>(), highest<TestType>())));
+    TestType x((U)raw);
+
+    SECTION("to double is exact") {
+        CHECK((double)x == (double)raw / TestType::SCALE);
+    }
+    SECTION("from double rounds to nearest") {
+        CHECK(TestType((double)x) == x);
+    }
+    SECTION("to_integer() rounds towards zero") {
+        CHECK(x.to_integer() == (U)(raw / TestType::SCALE));
+    }
+    SECTION("from_integer() is the inverse of to_integer()") {
+        CHECK(TestType::from_integer((int)x.to_integer()).to_integer() == x.to_integer());
+    }
+    SECTION("to and from PSXFixed truncates extra fraction bits towards zero") {
+        double truncated = (double)(std::int64_t)((double)x * PSXFixed::SCALE) / PSXFixed::SCALE;
+        CHECK((double)PSXFixed(x) == truncated);
+        // converting back only loses the fraction bits PSXFixed didn't have
+        CHECK((double)TestType(PSXFixed(x)) == truncated);
+    }
+    SECTION("to_c_str() gives the value to 6 decimal places") {
+        char output[32] = {};
+        REQUIRE(x.to_c_str(output, sizeof(output)));
+        CHECK(std::strtod(output, nullptr) == Approx((double)x).margin(0.000001));
+    }
+}
+
+TEST_CASE("Fixed conversion between formats is implicit only when lossless") {
+    STATIC_REQUIRE(std::is_convertible_v<Fixed<3, 12, std::int16_t>, PSXFixed>);
+    STATIC_REQUIRE(std::is_convertible_v<Fixed<8, 8, std::uint16_t>, PSXFixed>);
+    STATIC_REQUIRE_FALSE(std::is_convertible_v<PSXFixed, Fixed<3, 12, std::int16_t>>);
+    STATIC_REQUIRE_FALSE(std::is_convertible_v<Fixed<15, 16, std::int32_t>, PSXFixed>);
+    STATIC_REQUIRE_FALSE(std::is_convertible_v<Fixed<3, 12, std::int16_t>, Fixed<16, 16, std::uint32_t>>);
+    STATIC_REQUIRE(std::is_constructible_v<Fixed<3, 12, std::int16_t>, PSXFixed>);
+}
+
+TEST_CASE("Fixed to_c_str() buffer size depends on format") {
+    char output[16] = {};
+    CHECK_FALSE(Fixed<3, 12, std::int16_t>::MIN().to_c_str(output, 9));
+    REQUIRE(Fixed<3, 12, std::int16_t>::MIN().to_c_str(output, 10));
+    CHECK(std::string(output) == "-8.000000");
+    REQUIRE(Fixed<8, 8, std::uint16_t>::MAX().to_c_str(output, 11));
+    CHECK(std::string(output) == "255.996093");
+    CHECK_FALSE(PSXFixed::MIN().to_c_str(output, 14));
+}
@@ -0,0 +1,115 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+#include "int128.hpp"
+
+using namespace unmoving;
+
+// numerator / denominator, rounded to nearest with ties away from zero
+static Int128 round_quotient(Int128 numerator, Int128 denominator) {
+    bool negative = (numerator < 0) != (denominator < 0);
+    Int128 magnitude = numerator < 0 ? -numerator : numerator;
+    Int128 divisor = denominator < 0 ? -denominator : denominator;
+    Int128 quotient = magnitude / divisor + (2 * (magnitude % divisor) >= divisor ? 1 : 0);
+    return negative ? -quotient : quotient;
+}
+
+// checks result and overflow against the exact raw result, and result against the double-precision one
+template <typename T>
+static void check_result(T result, bool overflow, Int128 exact, double reference) {
+    using U = typename T::UnderlyingType;
+    using Limits = std::numeric_limits<U>;
+    CAPTURE((double)result, reference, overflow);
+    if (exact < (Int128)Limits::min()) {
+        CHECK(overflow);
+        CHECK(result == T::MIN());
+    } else if (exact > (Int128)Limits::max()) {
+        CHECK(overflow);
+        CHECK(result == T::MAX());
+    } else {
+        CHECK_FALSE(overflow);
+        CHECK(result == T((U)exact));
+        // rounded to nearest, allowing for the rounding error of the reference itself
+        CHECK(std::abs((double)result - reference) <= T::ACCURACY * (1.0 + 1e-9));
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "mul_div() and mul_shift() round once, to nearest",
+    "",
+    PSXFixed, PSXFixed16, (Fixed<8, 8, std::uint16_t>), (Fixed<16, 16, std::uint32_t>)
+) {
+    using U = typename TestType::UnderlyingType;
+    using Limits = std::numeric_limits<U>;
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    std::uniform_int_distribution<std::int64_t> distribution(Limits::min(), Limits::max());
+    // small values too, so that not every result overflows
+    std::uniform_int_distribution<std::int64_t> small(Limits::min() / 256, Limits::max() / 256);
+    U a = (U)distribution(engine), b = (U)small(engine), c = (U)distribution(engine);
+    double lhs = (double)TestType(a), rhs = (double)TestType(b), divisor = (double)TestType(c);
+
+    SECTION("mul_div()") {
+        if (c == 0) { c = 1; }
+        divisor = (double)TestType(c);
+        bool overflow = false;
+        TestType result = TestType::mul_div(TestType(a), TestType(b), TestType(c), &overflow);
+        // a * b / c, where the scales of the numerator and denominator cancel out but one
+        check_result(result, overflow, round_quotient((Int128)a * b, c), lhs * rhs / divisor);
+        // the out-parameter is optional
+        CHECK(TestType::mul_div(TestType(a), TestType(b), TestType(c)) == result);
+    }
+    SECTION("mul_div() by zero") {
+        bool overflow = false;
+        TestType result = TestType::mul_div(TestType(a), TestType(b), TestType(), &overflow);
+        CHECK(overflow);
+        CHECK(result == ((lhs < 0) != (rhs < 0) ? TestType::MIN() : TestType::MAX()));
+    }
+    SECTION("mul_shift()") {
+        std::size_t shift = std::uniform_int_distribution<std::size_t>(0, 31)(engine);
+        bool overflow = false;
+        TestType result = TestType::mul_shift(TestType(a), TestType(b), shift, &overflow);
+        Int128 exact = round_quotient((Int128)a * b, (Int128)1 << (TestType::FRACTION_BITS + shift));
+        check_result(result, overflow, exact, std::ldexp(lhs * rhs, -(int)shift));
+        CHECK(TestType::mul_shift(TestType(a), TestType(b), shift) == result);
+    }
+}
+
+TEST_CASE("mul_div() only overflows if the result does") {
+    bool overflow = true;
+    // the product alone is out of range of PSXFixed
+    CHECK(PSXFixed::mul_div(1000_fx, 1000_fx, 2000_fx, &overflow) == 500_fx);
+    CHECK_FALSE(overflow);
+    CHECK(PSXFixed::mul_div(-1000_fx, 1000_fx, 3_fx, &overflow) == PSXFixed::mul_div(1000_fx, 1000_fx, -3_fx));
+    CHECK_FALSE(overflow);
+    CHECK(PSXFixed::mul_div(1000_fx, 1000_fx, 1_fx, &overflow) == PSXFixed::MAX());
+    CHECK(overflow);
+}
+
+TEST_CASE("mul_div() and mul_shift() can be used at compile-time") {
+    STATIC_REQUIRE(PSXFixed::mul_div(1000_fx, 1000_fx, 2000_fx) == 500_fx);
+    STATIC_REQUIRE(PSXFixed::mul_div(3_fx, 4_fx, -8_fx) == -1.5_fx);
+    // halfway between two steps, so rounded away from zero
+    STATIC_REQUIRE(PSXFixed::mul_div(PSXFixed(1), PSXFixed(1), PSXFixed(2)) == PSXFixed(1));
+    STATIC_REQUIRE(PSXFixed::mul_div(PSXFixed(-1), PSXFixed(1), PSXFixed(2)) == PSXFixed(-1));
+    STATIC_REQUIRE(PSXFixed::mul_shift(3_fx, 0.5_fx, 1) == 0.75_fx);
+    STATIC_REQUIRE(PSXFixed::mul_shift(PSXFixed(3), 0.5_fx, 0) == PSXFixed(2));
+    STATIC_REQUIRE(PSXFixed16::mul_div(PSXFixed16(7.5), PSXFixed16(6.0), PSXFixed16(7.5)) == PSXFixed16(6.0));
+}
@@ -0,0 +1,161 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef COM_SAXBOPHONE_UNMOVING_TESTS_INT128_HPP
+#define COM_SAXBOPHONE_UNMOVING_TESTS_INT128_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * a signed two's complement 128-bit integer, for computing exact reference
+ * results in the tests, as not every compiler has one built in (MSVC doesn't)
+ *
+ * arithmetic wraps, and division rounds towards zero, as for built-in integers
+ */
+class Int128 {
+public:
+    constexpr Int128() = default;
+
+    template <std::integral T>
+    constexpr Int128(T value)
+      // sign-extended, as conversion to an unsigned type is modulo 2**64
+      : _hi(std::is_signed_v<T> and (std::int64_t)value < 0 ? ~(std::uint64_t)0 : 0)
+      , _lo((std::uint64_t)value)
+      {}
+
+    // the value wrapped to T
+    template <std::integral T>
+    explicit constexpr operator T() const {
+        return (T)this->_lo;
+    }
+
+    friend constexpr bool operator==(const Int128& lhs, const Int128& rhs) = default;
+
+    friend constexpr bool operator<(const Int128& lhs, const Int128& rhs) {
+        // compare the high words as signed, then the low ones as unsigned
+        if (lhs._hi != rhs._hi) { return (std::int64_t)lhs._hi < (std::int64_t)rhs._hi; }
+        return lhs._lo < rhs._lo;
+    }
+
+    friend constexpr bool operator>(const Int128& lhs, const Int128& rhs) { return rhs < lhs; }
+
+    friend constexpr bool operator<=(const Int128& lhs, const Int128& rhs) { return not (rhs < lhs); }
+
+    friend constexpr bool operator>=(const Int128& lhs, const Int128& rhs) { return not (lhs < rhs); }
+
+    friend constexpr Int128 operator+(const Int128& lhs, const Int128& rhs) {
+        std::uint64_t lo = lhs._lo + rhs._lo;
+        // carry out of the low word if it wrapped
+        return Int128(lhs._hi + rhs._hi + (lo < lhs._lo ? 1 : 0), lo);
+    }
+
+    constexpr Int128 operator-() const {
+        return Int128(~this->_hi, ~this->_lo) + 1;
+    }
+
+    friend constexpr Int128 operator-(const Int128& lhs, const Int128& rhs) {
+        return lhs + -rhs;
+    }
+
+    friend constexpr Int128 operator*(const Int128& lhs, const Int128& rhs) {
+        Int128 product = Int128::multiply(lhs._lo, rhs._lo);
+        // the cross products only affect the high word
+        product._hi += lhs._hi * rhs._lo + lhs._lo * rhs._hi;
+        return product;
+    }
+
+    friend constexpr Int128 operator/(const Int128& lhs, const Int128& rhs) {
+        Int128 quotient, remainder;
+        Int128::divide(lhs, rhs, quotient, remainder);
+        return quotient;
+    }
+
+    friend constexpr Int128 operator%(const Int128& lhs, const Int128& rhs) {
+        Int128 quotient, remainder;
+        Int128::divide(lhs, rhs, quotient, remainder);
+        return remainder;
+    }
+
+    friend constexpr Int128 operator<<(const Int128& lhs, std::size_t shift) {
+        if (shift == 0) { return lhs; }
+        if (shift >= 64) { return Int128(lhs._lo << (shift - 64), 0); }
+        return Int128(lhs._hi << shift | lhs._lo >> (64 - shift), lhs._lo << shift);
+    }
+
+    // arithmetic shift, so negative values are rounded towards negative infinity
+    friend constexpr Int128 operator>>(const Int128& lhs, std::size_t shift) {
+        if (shift == 0) { return lhs; }
+        std::uint64_t sign = lhs < 0 ? ~(std::uint64_t)0 : 0;
+        if (shift >= 64) { return Int128(sign, (std::uint64_t)((std::int64_t)lhs._hi >> (shift - 64))); }
+        return Int128((std::uint64_t)((std::int64_t)lhs._hi >> shift), lhs._lo >> shift | lhs._hi << (64 - shift));
+    }
+
+    constexpr Int128& operator+=(const Int128& other) { return *this = *this + other; }
+
+    constexpr Int128& operator-=(const Int128& other) { return *this = *this - other; }
+
+    constexpr Int128& operator*=(const Int128& other) { return *this = *this * other; }
+
+private:
+    constexpr Int128(std::uint64_t hi, std::uint64_t lo) : _hi(hi), _lo(lo) {}
+
+    // the full product of two 64-bit words, from the products of their 32-bit halves
+    static constexpr Int128 multiply(std::uint64_t lhs, std::uint64_t rhs) {
+        std::uint64_t lhs_lo = lhs & 0xFFFFFFFF, lhs_hi = lhs >> 32;
+        std::uint64_t rhs_lo = rhs & 0xFFFFFFFF, rhs_hi = rhs >> 32;
+        std::uint64_t low = lhs_lo * rhs_lo;
+        std::uint64_t middle_a = lhs_hi * rhs_lo;
+        std::uint64_t middle_b = lhs_lo * rhs_hi;
+        std::uint64_t high = lhs_hi * rhs_hi;
+        // sum of the 32-bit column at bit 32, which can't overflow 64 bits
+        std::uint64_t middle = (low >> 32) + (middle_a & 0xFFFFFFFF) + (middle_b & 0xFFFFFFFF);
+        return Int128(
+            high + (middle_a >> 32) + (middle_b >> 32) + (middle >> 32),
+            (middle << 32) | (low & 0xFFFFFFFF)
+        );
+    }
+
+    // division of the magnitudes by shifting and subtracting, then the signs of the results fixed
+    static constexpr void divide(const Int128& lhs, const Int128& rhs, Int128& quotient, Int128& remainder) {
+        Int128 dividend = lhs < 0 ? -lhs : lhs;
+        Int128 divisor = rhs < 0 ? -rhs : rhs;
+        quotient = 0;
+        remainder = 0;
+        for (std::size_t bit = 128; bit-- > 0; ) {
+            remainder = remainder << 1;
+            remainder._lo |= (bit >= 64 ? dividend._hi >> (bit - 64) : dividend._lo >> bit) & 1;
+            if (Int128::unsigned_less(remainder, divisor)) { continue; }
+            remainder -= divisor;
+            if (bit >= 64) {
+                quotient._hi |= (std::uint64_t)1 << (bit - 64);
+            } else {
+                quotient._lo |= (std::uint64_t)1 << bit;
+            }
+        }
+        // the quotient rounds towards zero, so the remainder has the sign of the dividend
+        if ((lhs < 0) != (rhs < 0)) { quotient = -quotient; }
+        if (lhs < 0) { remainder = -remainder; }
+    }
+
+    // comparison as unsigned, as the magnitude of the smallest value doesn't fit when signed
+    static constexpr bool unsigned_less(const Int128& lhs, const Int128& rhs) {
+        if (lhs._hi != rhs._hi) { return lhs._hi < rhs._hi; }
+        return lhs._lo < rhs._lo;
+    }
+
+    std::uint64_t _hi = 0;
+    std::uint64_t _lo = 0;
+};
+
+#endif // include guard
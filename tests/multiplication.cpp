@@ -9,7 +9,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
- #include <cmath>
+#include <cmath>
+#include <limits>
 
 #include <catch2/catch.hpp>
 
@@ -128,3 +129,53 @@ TEST_CASE("Multiplication") {
 
     }
 }
+
+TEST_CASE("32-bit-only multiplication matches 64-bit multiplication") {
+    SECTION("Over the full operand range") {
+        Underlying i = GENERATE(
+            take(
+                tests_config::ITERATIONS,
+                random(
+                    std::numeric_limits<Underlying>::min(),
+                    std::numeric_limits<Underlying>::max()
+                )
+            )
+        );
+        Underlying j = GENERATE(
+            take(
+                8,
+                random(
+                    std::numeric_limits<Underlying>::min(),
+                    std::numeric_limits<Underlying>::max()
+                )
+            )
+        );
+        CAPTURE(i, j);
+        REQUIRE(
+            detail::multiply_shift_narrow(i, j, PSXFixed::FRACTION_BITS) ==
+            detail::multiply_shift_wide(i, j, PSXFixed::FRACTION_BITS)
+        );
+    }
+
+    SECTION("At the edges of the operand range") {
+        Underlying i = GENERATE(
+            std::numeric_limits<Underlying>::min(),
+            std::numeric_limits<Underlying>::min() + 1,
+            -4097, -4096, -4095, -1, 0, 1, 4095, 4096, 4097,
+            std::numeric_limits<Underlying>::max() - 1,
+            std::numeric_limits<Underlying>::max()
+        );
+        Underlying j = GENERATE(
+            std::numeric_limits<Underlying>::min(),
+            std::numeric_limits<Underlying>::min() + 1,
+            -4097, -4096, -4095, -1, 0, 1, 4095, 4096, 4097,
+            std::numeric_limits<Underlying>::max() - 1,
+            std::numeric_limits<Underlying>::max()
+        );
+        CAPTURE(i, j);
+        REQUIRE(
+            detail::multiply_shift_narrow(i, j, PSXFixed::FRACTION_BITS) ==
+            detail::multiply_shift_wide(i, j, PSXFixed::FRACTION_BITS)
+        );
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <limits>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+using Underlying = PSXFixed::UnderlyingType;
+
+// checks that the approximate quotient is either exact or one step further from zero
+static void check_approximate_quotient(Underlying dividend, Underlying divisor, PSXFixed result) {
+    std::int64_t exact = (std::int64_t)dividend * PSXFixed::SCALE / divisor;
+    std::int64_t error = std::llabs((std::int64_t)(Underlying)result) - std::llabs(exact);
+    CAPTURE(dividend, divisor, (Underlying)result, exact);
+    REQUIRE((error == 0 or error == 1));
+    // the result never has the opposite sign of the exact quotient
+    REQUIRE((exact == 0 or ((Underlying)result < 0) == (exact < 0)));
+}
+
+TEST_CASE("Reciprocal") {
+    Underlying i = GENERATE(
+        take(
+            tests_config::ITERATIONS,
+            filter(
+                [](Underlying u) { return u != 0; },
+                random(
+                    std::numeric_limits<Underlying>::min(),
+                    std::numeric_limits<Underlying>::max()
+                )
+            )
+        )
+    );
+
+    SECTION("PSXFixed.fast_div() is accurate to 1 ULP") {
+        Underlying j = GENERATE_COPY(
+            take(
+                8,
+                filter(
+                    // verify exact quotient does not exceed bounds of PSXFixed type
+                    [=](Underlying u) {
+                        std::int64_t exact = (std::int64_t)u * PSXFixed::SCALE / i;
+                        return std::numeric_limits<Underlying>::min() <= exact and
+                            exact <= std::numeric_limits<Underlying>::max();
+                    },
+                    random(
+                        std::numeric_limits<Underlying>::min(),
+                        std::numeric_limits<Underlying>::max()
+                    )
+                )
+            )
+        );
+        check_approximate_quotient(j, i, PSXFixed(j).fast_div(PSXFixed(i)));
+    }
+
+    SECTION("PSXFixed.reciprocal() can be reused for many divisions") {
+        PSXFixed::Reciprocal reciprocal = PSXFixed(i).reciprocal();
+        for (Underlying j = -4096 * 8; j <= 4096 * 8; j += 4093) {
+            std::int64_t exact = (std::int64_t)j * PSXFixed::SCALE / i;
+            if (std::numeric_limits<Underlying>::min() <= exact and exact <= std::numeric_limits<Underlying>::max()) {
+                check_approximate_quotient(j, i, PSXFixed(j) * reciprocal);
+                check_approximate_quotient(j, i, reciprocal * PSXFixed(j));
+            }
+        }
+    }
+
+    SECTION("PSXFixed.reciprocal() cast to PSXFixed is accurate to 1 ULP") {
+        std::int64_t exact = (std::int64_t)PSXFixed::SCALE * PSXFixed::SCALE / i;
+        if (std::numeric_limits<Underlying>::min() <= exact and exact <= std::numeric_limits<Underlying>::max()) {
+            check_approximate_quotient(PSXFixed::SCALE, i, (PSXFixed)PSXFixed(i).reciprocal());
+        }
+    }
+}
+
+TEST_CASE("Reciprocal of powers of two is exact") {
+    int power = GENERATE(range(0, 31));
+    Underlying divisor = (Underlying)(1u << power);
+    Underlying j = GENERATE(
+        take(
+            tests_config::ITERATIONS / 100,
+            random(
+                std::numeric_limits<Underlying>::min(),
+                std::numeric_limits<Underlying>::max()
+            )
+        )
+    );
+    std::int64_t exact = (std::int64_t)j * PSXFixed::SCALE / divisor;
+    if (std::numeric_limits<Underlying>::min() <= exact and exact <= std::numeric_limits<Underlying>::max()) {
+        CAPTURE(j, divisor);
+        REQUIRE(PSXFixed(j).fast_div(PSXFixed(divisor)) == PSXFixed(j) / PSXFixed(divisor));
+        REQUIRE(PSXFixed(j).fast_div(-PSXFixed(divisor)) == PSXFixed(j) / -PSXFixed(divisor));
+    }
+}
+
+TEST_CASE("Reciprocal can be evaluated at compile-time") {
+    STATIC_REQUIRE(6.0_fx .fast_div(3.0_fx) == 2.0_fx);
+    STATIC_REQUIRE((PSXFixed)(0.5_fx).reciprocal() == 2.0_fx);
+    STATIC_REQUIRE(1.0_fx * (-0.25_fx).reciprocal() == -4.0_fx);
+}
@@ -0,0 +1,71 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cmath>
+#include <cstdint>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/roots.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+/*
+ * the double-precision results are close enough to exact that rounding them
+ * gives the correctly-rounded result, as no result is close to halfway
+ * between two PSXFixed values
+ */
+static PSXFixed reference_sqrt(std::int32_t raw) {
+    return PSXFixed((std::int32_t)std::lround(std::sqrt((double)raw * PSXFixed::SCALE)));
+}
+
+static PSXFixed reference_rsqrt(std::int32_t raw) {
+    return PSXFixed((std::int32_t)std::lround(PSXFixed::SCALE * std::sqrt((double)PSXFixed::SCALE) / std::sqrt((double)raw)));
+}
+
+TEST_CASE("sqrt() and rsqrt() are correctly rounded") {
+    std::int32_t raw = GENERATE(
+        take(tests_config::ITERATIONS, random(1, 0x7FFFFFFF)),
+        // small values, which have the largest reciprocal square roots
+        take(tests_config::ITERATIONS, random(1, 0x10000)),
+        range(1, 256),
+        0x7FFFFFFF
+    );
+    CAPTURE(raw);
+    CHECK(unmoving::sqrt(PSXFixed(raw)) == reference_sqrt(raw));
+    CHECK(unmoving::rsqrt(PSXFixed(raw)) == reference_rsqrt(raw));
+}
+
+TEST_CASE("sqrt() and rsqrt() are correctly rounded for every non-negative value", "[.][exhaustive]") {
+    // counting down, so that the loop ends without overflowing
+    for (std::int32_t raw = 0x7FFFFFFF; raw > 0; raw--) {
+        REQUIRE(unmoving::sqrt(PSXFixed(raw)) == reference_sqrt(raw));
+        REQUIRE(unmoving::rsqrt(PSXFixed(raw)) == reference_rsqrt(raw));
+    }
+}
+
+TEST_CASE("sqrt() and rsqrt() of values which have no root") {
+    std::int32_t raw = GENERATE(take(tests_config::ITERATIONS, random(-0x7FFFFFFF - 1, 0)));
+    CHECK(unmoving::sqrt(PSXFixed(raw)) == 0_fx);
+    CHECK(unmoving::rsqrt(PSXFixed(raw)) == PSXFixed::MAX());
+}
+
+TEST_CASE("sqrt() and rsqrt() can be used at compile-time") {
+    STATIC_REQUIRE(unmoving::sqrt(0_fx) == 0_fx);
+    STATIC_REQUIRE(unmoving::sqrt(1_fx) == 1_fx);
+    STATIC_REQUIRE(unmoving::sqrt(2.25_fx) == 1.5_fx);
+    STATIC_REQUIRE(unmoving::sqrt(PSXFixed(1)) == PSXFixed(64));
+    STATIC_REQUIRE(unmoving::rsqrt(0.25_fx) == 2_fx);
+    STATIC_REQUIRE(unmoving::rsqrt(16_fx) == 0.25_fx);
+    STATIC_REQUIRE(unmoving::rsqrt(PSXFixed(1)) == 64_fx);
+}
@@ -0,0 +1,100 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cstdint>
+#include <iterator>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/PSXFixed16x2.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+// lane values which exercise the carries and borrows between lanes
+static const int EDGES[] = {0, 1, -1, 2, -2, 0x7FFF, -0x7FFF - 1, 0x4000, -0x4000, 0x0FFF, -0x1000};
+
+TEST_CASE("PSXFixed16x2 packs and unpacks lanes") {
+    std::int16_t low = GENERATE(take(tests_config::ITERATIONS, random(INT16_MIN, INT16_MAX)));
+    std::int16_t high = GENERATE(take(1, random(INT16_MIN, INT16_MAX)));
+    PSXFixed16x2 pair(PSXFixed16{low}, PSXFixed16{high});
+
+    CHECK((PSXFixed16::UnderlyingType)pair.low() == low);
+    CHECK((PSXFixed16::UnderlyingType)pair.high() == high);
+    CHECK((PSXFixed16x2::UnderlyingType)pair == ((std::uint32_t)(std::uint16_t)high << 16 | (std::uint16_t)low));
+    PSXFixed16 unpacked_low, unpacked_high;
+    pair.unpack(unpacked_low, unpacked_high);
+    CHECK(unpacked_low == pair.low());
+    CHECK(unpacked_high == pair.high());
+    PSXFixed16x2 splatted = PSXFixed16x2::splat(PSXFixed16{low});
+    CHECK(splatted.low() == splatted.high());
+    CHECK((PSXFixed16::UnderlyingType)splatted.high() == low);
+}
+
+TEST_CASE("PSXFixed16x2 lane-wise operations match PSXFixed16 operations") {
+    std::int16_t a = GENERATE(
+        take(tests_config::ITERATIONS / 10, random(INT16_MIN, INT16_MAX)),
+        from_range(std::begin(EDGES), std::end(EDGES))
+    );
+    std::int16_t b = GENERATE(take(1, random(INT16_MIN, INT16_MAX)), from_range(std::begin(EDGES), std::end(EDGES)));
+    // swap the operands over for the high lane, so both lanes see all the edge cases
+    std::int16_t c = b, d = a;
+    PSXFixed16 lhs_low{a}, lhs_high{c}, rhs_low{b}, rhs_high{d};
+    PSXFixed16x2 lhs(lhs_low, lhs_high), rhs(rhs_low, rhs_high);
+
+    SECTION("Addition") {
+        PSXFixed16x2 sum = lhs + rhs;
+        CHECK(sum.low() == lhs_low + rhs_low);
+        CHECK(sum.high() == lhs_high + rhs_high);
+    }
+    SECTION("Subtraction") {
+        PSXFixed16x2 difference = lhs - rhs;
+        CHECK(difference.low() == lhs_low - rhs_low);
+        CHECK(difference.high() == lhs_high - rhs_high);
+    }
+    SECTION("Negation") {
+        PSXFixed16x2 negated = -lhs;
+        CHECK(negated.low() == -lhs_low);
+        CHECK(negated.high() == -lhs_high);
+    }
+    SECTION("Shifts") {
+        std::size_t shift = GENERATE(range(0U, 16U));
+        PSXFixed16x2 left = lhs << shift, right = lhs >> shift;
+        CHECK((PSXFixed16::UnderlyingType)left.low() == (std::int16_t)(std::uint16_t)((std::uint32_t)a << shift));
+        CHECK((PSXFixed16::UnderlyingType)left.high() == (std::int16_t)(std::uint16_t)((std::uint32_t)c << shift));
+        CHECK((PSXFixed16::UnderlyingType)right.low() == (std::int16_t)(a >> shift));
+        CHECK((PSXFixed16::UnderlyingType)right.high() == (std::int16_t)(c >> shift));
+    }
+    SECTION("Comparisons") {
+        std::uint32_t equal = PSXFixed16x2::equal_mask(lhs, rhs);
+        CHECK((equal & 0xFFFFu) == (a == b ? 0xFFFFu : 0u));
+        CHECK((equal >> 16) == (c == d ? 0xFFFFu : 0u));
+        std::uint32_t less = PSXFixed16x2::less_mask(lhs, rhs);
+        CHECK((less & 0xFFFFu) == (a < b ? 0xFFFFu : 0u));
+        CHECK((less >> 16) == (c < d ? 0xFFFFu : 0u));
+        CHECK(PSXFixed16x2::equal_mask(lhs, lhs) == 0xFFFFFFFFu);
+        CHECK(PSXFixed16x2::less_mask(lhs, lhs) == 0u);
+    }
+    SECTION("Selection") {
+        PSXFixed16x2 minimum = PSXFixed16x2::select(PSXFixed16x2::less_mask(lhs, rhs), lhs, rhs);
+        CHECK((PSXFixed16::UnderlyingType)minimum.low() == (a < b ? a : b));
+        CHECK((PSXFixed16::UnderlyingType)minimum.high() == (c < d ? c : d));
+    }
+}
+
+TEST_CASE("PSXFixed16x2 can be used at compile-time") {
+    constexpr PSXFixed16x2 position(PSXFixed16(1.5), PSXFixed16(-2.25));
+    constexpr PSXFixed16x2 velocity(PSXFixed16(0.5), PSXFixed16(0.25));
+    STATIC_REQUIRE((position + velocity).low() == PSXFixed16(2.0));
+    STATIC_REQUIRE((position + velocity).high() == PSXFixed16(-2.0));
+    STATIC_REQUIRE((position >> 1).high() == PSXFixed16(-1.125));
+}
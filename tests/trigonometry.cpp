@@ -0,0 +1,144 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <unmoving/trigonometry.hpp>
+
+#include "config.hpp"
+
+using namespace unmoving;
+
+static constexpr double TAU = 6.283185307179586;
+
+// rounding of the table entries and of the interpolation (in 1.15), then to 20.12, plus the interpolation error
+static const double MAX_ERROR = 0.5 / 32768.0 * 2.0 + PSXFixed::ACCURACY
+    + std::pow(TAU / 4.0 / (1 << UNMOVING_SINE_TABLE_BITS), 2.0) / 8.0;
+
+TEST_CASE("sin() and cos() are accurate for every angle in a turn") {
+    // every angle there is, as there are only 4096 of them
+    for (std::int32_t angle = 0; angle < 4096; angle++) {
+        CAPTURE(angle);
+        REQUIRE(std::abs((double)unmoving::sin(PSXFixed(angle)) - std::sin(TAU * angle / 4096.0)) <= MAX_ERROR);
+        REQUIRE(std::abs((double)unmoving::cos(PSXFixed(angle)) - std::cos(TAU * angle / 4096.0)) <= MAX_ERROR);
+    }
+}
+
+// smaller tables are allowed, but less accurate than this
+#if UNMOVING_SINE_TABLE_BITS >= 6
+TEST_CASE("sin() and cos() are within one step with tables of 6 bits or more") {
+    REQUIRE(MAX_ERROR < PSXFixed::PRECISION);
+}
+#endif
+
+TEST_CASE("sin() and cos() wrap angles outside of one turn around") {
+    std::int32_t angle = GENERATE(take(tests_config::ITERATIONS, random(-0x7FFFFFFF - 1, 0x7FFFFFFF)));
+    PSXFixed wrapped(angle & 4095);
+    CHECK(unmoving::sin(PSXFixed(angle)) == unmoving::sin(wrapped));
+    CHECK(unmoving::cos(PSXFixed(angle)) == unmoving::cos(wrapped));
+}
+
+TEST_CASE("sin() and cos() are symmetric") {
+    std::int32_t angle = GENERATE(range(0, 4096));
+    PSXFixed x(angle);
+    CHECK(unmoving::sin(-x) == -unmoving::sin(x));
+    CHECK(unmoving::sin(0.5_fx - x) == unmoving::sin(x));
+    CHECK(unmoving::cos(-x) == unmoving::cos(x));
+    CHECK(unmoving::cos(x) == unmoving::sin(x + 0.25_fx));
+}
+
+TEST_CASE("sin() and cos() are exact at multiples of a quarter turn and can be used at compile-time") {
+    STATIC_REQUIRE(unmoving::sin(0.0_fx) == 0.0_fx);
+    STATIC_REQUIRE(unmoving::sin(0.25_fx) == 1.0_fx);
+    STATIC_REQUIRE(unmoving::sin(0.5_fx) == 0.0_fx);
+    STATIC_REQUIRE(unmoving::sin(0.75_fx) == -1.0_fx);
+    STATIC_REQUIRE(unmoving::cos(0.0_fx) == 1.0_fx);
+    STATIC_REQUIRE(unmoving::cos(0.5_fx) == -1.0_fx);
+    STATIC_REQUIRE(unmoving::cos(-0.25_fx) == 0.0_fx);
+}
+
+// angle in 4096ths of a turn from a to b, the short way round
+static double angle_between(double a, double b) {
+    double difference = std::fmod(std::abs(a - b), 4096.0);
+    return difference > 2048.0 ? 4096.0 - difference : difference;
+}
+
+TEST_CASE("atan2() and to_polar() are accurate") {
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    // vectors of all sizes, as they are scaled to the same size before rotating
+    std::int32_t limit = 0x3FFFFFFF >> GENERATE(0, 4, 12, 20, 28);
+    std::uniform_int_distribution<std::int32_t> distribution(-limit, limit);
+    std::int32_t x = distribution(engine), y = distribution(engine);
+    CAPTURE(x, y);
+    double exact_angle = std::atan2((double)y, (double)x) / TAU * 4096.0;
+    double exact_length = std::hypot((double)x, (double)y);
+
+    PSXFixed angle = unmoving::atan2(PSXFixed(y), PSXFixed(x));
+    // rounded to the nearest angle, give or take the error in the CORDIC angle table
+    CHECK(angle_between((PSXFixed::UnderlyingType)angle, exact_angle) <= 0.5 + 1e-5);
+    CHECK(-2048 < (PSXFixed::UnderlyingType)angle);
+    CHECK((PSXFixed::UnderlyingType)angle <= 2048);
+
+    PSXFixed polar_angle, length;
+    unmoving::to_polar(PSXFixed(x), PSXFixed(y), polar_angle, length);
+    CHECK(polar_angle == angle);
+    CHECK(std::abs((PSXFixed::UnderlyingType)length - exact_length) <= 0.5 + exact_length * std::ldexp(1.0, -25));
+}
+
+TEST_CASE("from_polar() is accurate") {
+    std::mt19937 engine(GENERATE(take(tests_config::ITERATIONS, random(0u, 0xFFFFFFFFu))));
+    std::int32_t limit = 0x7FFFFFFF >> GENERATE(1, 4, 12, 20, 28);
+    std::int32_t length = std::uniform_int_distribution<std::int32_t>(-limit, limit)(engine);
+    std::int32_t angle = std::uniform_int_distribution<std::int32_t>(-8192, 8192)(engine);
+    CAPTURE(length, angle);
+    double tolerance = 0.5 + std::abs(length) * std::ldexp(1.0, -25);
+
+    PSXFixed x, y;
+    unmoving::from_polar(PSXFixed(angle), PSXFixed(length), x, y);
+    CHECK(std::abs((PSXFixed::UnderlyingType)x - length * std::cos(TAU * angle / 4096.0)) <= tolerance);
+    CHECK(std::abs((PSXFixed::UnderlyingType)y - length * std::sin(TAU * angle / 4096.0)) <= tolerance);
+}
+
+TEST_CASE("from_polar() and to_polar() round-trip") {
+    std::int32_t angle = GENERATE(range(-2047, 2049));
+    // long enough that the angle can be recovered exactly
+    std::int32_t length = GENERATE(0x10000, 0x1000000);
+    PSXFixed x, y, recovered_angle, recovered_length;
+    unmoving::from_polar(PSXFixed(angle), PSXFixed(length), x, y);
+    unmoving::to_polar(x, y, recovered_angle, recovered_length);
+    CHECK(recovered_angle == PSXFixed(angle));
+    CHECK(std::abs((PSXFixed::UnderlyingType)recovered_length - length) <= 1);
+}
+
+TEST_CASE("atan2(), to_polar() and from_polar() can be used at compile-time") {
+    STATIC_REQUIRE(unmoving::atan2(0_fx, 0_fx) == 0_fx);
+    STATIC_REQUIRE(unmoving::atan2(0_fx, 1_fx) == 0_fx);
+    STATIC_REQUIRE(unmoving::atan2(1_fx, 0_fx) == 0.25_fx);
+    STATIC_REQUIRE(unmoving::atan2(0_fx, -1_fx) == 0.5_fx);
+    STATIC_REQUIRE(unmoving::atan2(-1_fx, 0_fx) == -0.25_fx);
+    STATIC_REQUIRE(unmoving::atan2(-3_fx, -3_fx) == -0.375_fx);
+    constexpr PSXFixed LENGTH = [] {
+        PSXFixed angle, length;
+        unmoving::to_polar(3_fx, -4_fx, angle, length);
+        return length;
+    }();
+    STATIC_REQUIRE(LENGTH == 5_fx);
+    constexpr PSXFixed X = [] {
+        PSXFixed x, y;
+        unmoving::from_polar(0.5_fx, 2_fx, x, y);
+        return x;
+    }();
+    STATIC_REQUIRE(X == -2_fx);
+}
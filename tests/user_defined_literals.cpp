@@ -9,7 +9,9 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
- #include <catch2/catch.hpp>
+#include <cstdint>
+
+#include <catch2/catch.hpp>
 
 #include <unmoving/PSXFixed.hpp>
 
@@ -62,3 +64,88 @@ TEST_CASE("User-defined literals") {
         REQUIRE((double)foo == Approx(std::get<double>(literal_to_value)).margin(PSXFixed::ACCURACY));
     }
 }
+
+TEST_CASE("User-defined literals are rounded exactly") {
+    SECTION("Halfway between two steps rounds away from zero") {
+        STATIC_REQUIRE(0.0001220703125_fx == PSXFixed(1));
+        STATIC_REQUIRE(0.0003662109375_fx == PSXFixed(2));
+        STATIC_REQUIRE(1.0001220703125_fx == PSXFixed(4097));
+    }
+    SECTION("Digits beyond the precision of double still decide the rounding") {
+        // these both become exactly halfway between two steps when converted to double
+        STATIC_REQUIRE(0.000122070312499999999999_fx == PSXFixed(0));
+        STATIC_REQUIRE(1.000122070312499999999999_fx == PSXFixed(4096));
+        STATIC_REQUIRE(0.000122070312500000000000000000000000001_fx == PSXFixed(1));
+    }
+    SECTION("Every step can be written exactly") {
+        STATIC_REQUIRE(0.000244140625_fx == PSXFixed(1));
+        STATIC_REQUIRE(123.456787109375_fx == PSXFixed(505679));
+        STATIC_REQUIRE(524287.999755859375_fx == PSXFixed::MAX());
+        STATIC_REQUIRE(524287_fx == PSXFixed(524287 << 12));
+    }
+    SECTION("Literals too small to reach half a step are zero") {
+        STATIC_REQUIRE(0.0001_fx == 0_fx);
+        STATIC_REQUIRE(1e-100_fx == 0_fx);
+        STATIC_REQUIRE(0x1p-100_fx == 0_fx);
+        STATIC_REQUIRE(0.0_fx == 0_fx);
+        STATIC_REQUIRE(0e1000_fx == 0_fx);
+    }
+}
+
+TEST_CASE("User-defined literals in other forms") {
+    SECTION("Exponents") {
+        STATIC_REQUIRE(1e3_fx == 1000_fx);
+        STATIC_REQUIRE(1.5E-1_fx == 0.15_fx);
+        STATIC_REQUIRE(25e-2_fx == 0.25_fx);
+        STATIC_REQUIRE(0.00025e+3_fx == 0.25_fx);
+        STATIC_REQUIRE(5.24287e5_fx == 524287_fx);
+    }
+    SECTION("Hexadecimal, octal and binary") {
+        STATIC_REQUIRE(0x10_fx == 16_fx);
+        STATIC_REQUIRE(0XfF_fx == 255_fx);
+        STATIC_REQUIRE(017_fx == 15_fx);
+        STATIC_REQUIRE(0b101_fx == 5_fx);
+        STATIC_REQUIRE(0x1p-3_fx == 0.125_fx);
+        STATIC_REQUIRE(0x1.8p1_fx == 3_fx);
+        STATIC_REQUIRE(0x.001p0_fx == PSXFixed(1));
+        STATIC_REQUIRE(0x.0008p0_fx == PSXFixed(1));
+        STATIC_REQUIRE(0x.0007FFFFFFFFFFFFFFFFFFFFFp0_fx == PSXFixed(0));
+        STATIC_REQUIRE(0x7FFFF.FFFp0_fx == PSXFixed::MAX());
+    }
+    SECTION("Leading zeros and digit separators") {
+        STATIC_REQUIRE(0.5_fx == 00.5_fx);
+        STATIC_REQUIRE(012.5_fx == 12.5_fx);
+        STATIC_REQUIRE(1'000.000'5_fx == 1000.0005_fx);
+        STATIC_REQUIRE(0x1'0_fx == 16_fx);
+    }
+}
+
+using UV = Fixed<8, 8, std::uint16_t>;
+
+template <char... Literal>
+consteval UV operator"" _uv() {
+    return UV::from_literal<Literal...>();
+}
+
+TEST_CASE("Literals of other formats are rounded once, to nearest") {
+    SECTION("Formats with fewer fraction bits") {
+        // 255.744 steps, where converting 0.999_fx would truncate to 255
+        STATIC_REQUIRE(0.999_uv == UV((std::uint16_t)256));
+        STATIC_REQUIRE(UV(0.999_fx) == UV((std::uint16_t)255));
+        // half a step, rounded away from zero
+        STATIC_REQUIRE(0.001953125_uv == UV((std::uint16_t)1));
+        STATIC_REQUIRE(0.001953124_uv == UV((std::uint16_t)0));
+        STATIC_REQUIRE(255.99609375_uv == UV::MAX());
+        STATIC_REQUIRE(UV::from_literal<'1', '.', '5'>() == UV((std::uint16_t)384));
+    }
+    SECTION("Formats with more fraction bits") {
+        using Unit = Fixed<1, 30, std::int32_t>;
+        STATIC_REQUIRE(Unit::from_literal<'0', '.', '1'>() == Unit(107'374'182));
+        STATIC_REQUIRE(Unit::from_literal<'1'>() == Unit(1 << 30));
+    }
+    SECTION("PSXFixed16") {
+        STATIC_REQUIRE(0.5_fx16 == PSXFixed16((std::int16_t)2048));
+        STATIC_REQUIRE(7.999755859375_fx16 == PSXFixed16::MAX());
+        STATIC_REQUIRE(PSXFixed(1.25_fx16) == 1.25_fx);
+    }
+}
@@ -0,0 +1,217 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#ifndef COM_SAXBOPHONE_UNMOVING_TESTS_VERIFY_ENGINE_HPP
+#define COM_SAXBOPHONE_UNMOVING_TESTS_VERIFY_ENGINE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace verify {
+    // where a candidate implementation first disagreed with the reference
+    struct Mismatch {
+        std::uint64_t index;
+        std::string description;
+    };
+
+    /*
+     * a check of every index in [0, size), done a chunk at a time: run(begin, end)
+     * checks [begin, end) and returns the first mismatch in it, if any
+     */
+    struct Check {
+        std::string name;
+        std::uint64_t size;
+        std::function<std::optional<Mismatch>(std::uint64_t begin, std::uint64_t end)> run;
+    };
+
+    // the outcome of running a check
+    struct Result {
+        std::uint64_t checked;
+        std::uint64_t mismatches;
+        std::optional<Mismatch> first;
+        double seconds;
+    };
+
+    // large enough that taking a chunk costs nothing next to checking it
+    constexpr std::uint64_t CHUNK = 1 << 16;
+
+    /*
+     * hands out chunks of [0, size) to workers, each of which starts with an
+     * equal share of it and steals half of the biggest remaining share when
+     * it runs out, so that all of them stay busy even when some chunks take
+     * much longer than others
+     */
+    class Scheduler {
+    public:
+        Scheduler(std::uint64_t size, std::size_t workers)
+          : _shares(std::make_unique<Share[]>(workers))
+          , _workers(workers)
+          {
+            for (std::size_t i = 0; i < workers; i++) {
+                _shares[i].begin = size / workers * i;
+                _shares[i].end = i + 1 == workers ? size : size / workers * (i + 1);
+            }
+        }
+
+        // the next chunk for worker to check, or false if there are none left
+        bool next(std::size_t worker, std::uint64_t& begin, std::uint64_t& end) {
+            while (true) {
+                {
+                    std::lock_guard lock(_shares[worker].mutex);
+                    Share& own = _shares[worker];
+                    if (own.begin < own.end) {
+                        begin = own.begin;
+                        end = std::min(own.end, begin + CHUNK);
+                        own.begin = end;
+                        return true;
+                    }
+                }
+                if (not steal(worker)) { return false; }
+            }
+        }
+
+    private:
+        struct alignas(64) Share {
+            std::mutex mutex;
+            std::uint64_t begin = 0;
+            std::uint64_t end = 0;
+        };
+
+        // moves the back half of the biggest share into worker's, or returns false if there's nothing to take
+        bool steal(std::size_t worker) {
+            while (true) {
+                std::size_t victim = _workers;
+                std::uint64_t biggest = 0;
+                for (std::size_t i = 0; i < _workers; i++) {
+                    std::lock_guard lock(_shares[i].mutex);
+                    std::uint64_t remaining = _shares[i].end - _shares[i].begin;
+                    if (remaining > biggest) {
+                        biggest = remaining;
+                        victim = i;
+                    }
+                }
+                if (victim == _workers) { return false; }
+                std::uint64_t begin, end;
+                {
+                    std::lock_guard lock(_shares[victim].mutex);
+                    Share& share = _shares[victim];
+                    // it may have been taken from since it was looked at
+                    if (share.begin >= share.end) { continue; }
+                    // a share of a chunk or less is taken whole
+                    std::uint64_t remaining = share.end - share.begin;
+                    begin = remaining <= CHUNK ? share.begin : share.begin + remaining / 2;
+                    end = share.end;
+                    share.end = begin;
+                }
+                std::lock_guard lock(_shares[worker].mutex);
+                _shares[worker].begin = begin;
+                _shares[worker].end = end;
+                return true;
+            }
+        }
+
+        std::unique_ptr<Share[]> _shares;
+        std::size_t _workers;
+    };
+
+    struct Options {
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        // whether to carry on after a mismatch to count them all, rather than stopping as soon as possible
+        bool keep_going = false;
+        // whether to print progress to stderr
+        bool progress = true;
+    };
+
+    /*
+     * runs check over all of its indices on options.threads threads, finding
+     * the lowest index which doesn't match: after a mismatch, only chunks
+     * before it are checked (unless keeping going)
+     */
+    inline Result run(const Check& check, const Options& options) {
+        Scheduler scheduler(check.size, options.threads);
+        std::atomic<std::uint64_t> checked = 0;
+        std::atomic<std::uint64_t> mismatches = 0;
+        std::atomic<std::uint64_t> first_index = std::numeric_limits<std::uint64_t>::max();
+        std::optional<Mismatch> first;
+        std::mutex first_mutex;
+        auto start = std::chrono::steady_clock::now();
+
+        auto work = [&](std::size_t worker) {
+            std::uint64_t begin, end;
+            while (scheduler.next(worker, begin, end)) {
+                if (not options.keep_going and begin > first_index.load(std::memory_order_relaxed)) {
+                    // can't find an earlier mismatch here
+                    checked += end - begin;
+                    continue;
+                }
+                std::uint64_t position = begin;
+                while (position < end) {
+                    std::optional<Mismatch> mismatch = check.run(position, end);
+                    if (not mismatch) { break; }
+                    mismatches++;
+                    {
+                        std::lock_guard lock(first_mutex);
+                        if (mismatch->index < first_index) {
+                            first_index = mismatch->index;
+                            first = mismatch;
+                        }
+                    }
+                    if (not options.keep_going) { break; }
+                    position = mismatch->index + 1;
+                }
+                checked += end - begin;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < options.threads; i++) {
+            threads.emplace_back(work, i);
+        }
+        if (options.progress) {
+            // report progress every second until every index has been checked
+            auto last_report = start;
+            while (checked < check.size) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                if (std::chrono::steady_clock::now() - last_report < std::chrono::seconds(1)) { continue; }
+                last_report = std::chrono::steady_clock::now();
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::uint64_t done = checked;
+                double rate = (double)done / seconds;
+                std::fprintf(
+                    stderr, "\r%s: %5.1f%% (%.1fM per second, %.0fs left)%s    ",
+                    check.name.c_str(), 100.0 * (double)done / (double)check.size, rate / 1e6,
+                    rate > 0 ? (double)(check.size - done) / rate : 0.0,
+                    mismatches > 0 ? ", MISMATCHED" : ""
+                );
+            }
+            if (last_report != start) { std::fputs("\n", stderr); }
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return {checked, mismatches, first, seconds};
+    }
+}
+
+#endif // include guard
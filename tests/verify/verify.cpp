@@ -0,0 +1,294 @@
+/*
+ * This source file forms part of Unmoving
+ * Unmoving is a C++ header-only library providing more convenient fixed-point
+ * arithmetic for the Sony PlayStation ("PS1").
+ *
+ * Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+/*
+ * Checks implementations of PSXFixed operations against reference ones over
+ * the whole range of raw values, or a part of it, using every core.
+ *
+ * Usage: verify [options] [check...]
+ *
+ *   --list              list the checks and exit
+ *   --threads N         number of threads to use (default: one per core)
+ *   --lhs FIRST:LAST    raw values to check (default: all of them)
+ *   --rhs-random N      random right-hand operands to check binary operations
+ *                       with, as well as the structured ones (default: 16)
+ *   --seed N            seed for the random right-hand operands (default: 0)
+ *   --keep-going        count every mismatch rather than stopping at the first
+ *   --quiet             don't report progress
+ *
+ * Unary checks are run over every raw value in the --lhs range. Binary checks
+ * are run over every raw value in the --lhs range as the left-hand operand,
+ * with each of a set of right-hand operands: powers of two and the values
+ * either side of them, negated too, along with the extremes of the range and
+ * some random values. All of the unary checks are run if none are named.
+ *
+ * Candidate implementations are compared with reference ones which are
+ * simpler or use wider arithmetic, so that faster implementations can be
+ * proved correct over the whole domain before they are used. The first
+ * mismatch (that with the lowest index) is reported for each check, and the
+ * exit status is non-zero if there are any.
+ */
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unmoving/PSXFixed.hpp>
+#include <unmoving/roots.hpp>
+
+#include "engine.hpp"
+
+using namespace unmoving;
+
+using Raw = PSXFixed::UnderlyingType;
+
+namespace {
+    // the raw values to check, as the left-hand operands of binary operations
+    struct Domain {
+        Raw first;
+        Raw last;
+
+        std::uint64_t size() const {
+            return (std::uint64_t)((std::int64_t)last - first) + 1;
+        }
+
+        Raw operator[](std::uint64_t index) const {
+            return (Raw)((std::int64_t)first + (std::int64_t)index);
+        }
+    };
+
+    /*
+     * a check which calls compare(raw) for each raw value in domain, where
+     * compare returns a description of the mismatch if there is one
+     */
+    template <typename Compare>
+    verify::Check unary(std::string name, Domain domain, Compare compare) {
+        return {
+            name,
+            domain.size(),
+            [domain, compare](std::uint64_t begin, std::uint64_t end) -> std::optional<verify::Mismatch> {
+                for (std::uint64_t index = begin; index < end; index++) {
+                    if (std::optional<std::string> mismatch = compare(domain[index])) {
+                        return verify::Mismatch{index, *mismatch};
+                    }
+                }
+                return std::nullopt;
+            },
+        };
+    }
+
+    // the same as unary(), but calling compare(lhs, rhs) for each lhs in domain with each of rhs
+    template <typename Compare>
+    verify::Check binary(std::string name, Domain domain, std::vector<Raw> rhs, Compare compare) {
+        return {
+            name,
+            domain.size() * rhs.size(),
+            [domain, rhs, compare](std::uint64_t begin, std::uint64_t end) -> std::optional<verify::Mismatch> {
+                std::uint64_t size = domain.size();
+                for (std::uint64_t index = begin; index < end; index++) {
+                    if (std::optional<std::string> mismatch = compare(domain[index % size], rhs[index / size])) {
+                        return verify::Mismatch{index, *mismatch};
+                    }
+                }
+                return std::nullopt;
+            },
+        };
+    }
+
+    // a description of a mismatch between the raw results of a candidate and the reference
+    template <typename... Operands>
+    std::optional<std::string> compare(const char* format, Raw candidate, Raw reference, Operands... operands) {
+        if (candidate == reference) { return std::nullopt; }
+        char description[128] = {};
+        std::snprintf(description, sizeof(description), format, operands..., candidate, reference);
+        return description;
+    }
+
+    /*
+     * the double-precision results are close enough to exact that rounding them
+     * gives the correctly-rounded result, as no result is close to halfway
+     * between two PSXFixed values
+     */
+    Raw reference_sqrt(Raw raw) {
+        if (raw <= 0) { return 0; }
+        return (Raw)std::lround(std::sqrt((double)raw * PSXFixed::SCALE));
+    }
+
+    Raw reference_rsqrt(Raw raw) {
+        if (raw <= 0) { return PSXFixed::MAX(); }
+        return (Raw)std::lround(PSXFixed::SCALE * std::sqrt((double)PSXFixed::SCALE) / std::sqrt((double)raw));
+    }
+
+    // powers of two and their neighbours, of both signs, and the extremes of the range
+    std::vector<Raw> structured_operands(std::size_t random_count, unsigned seed) {
+        std::set<Raw> operands = {std::numeric_limits<Raw>::min(), std::numeric_limits<Raw>::max()};
+        for (std::size_t bit = 0; bit < 31; bit++) {
+            Raw power = (Raw)1 << bit;
+            for (Raw value : {power - 1, power, power + 1}) {
+                operands.insert(value);
+                operands.insert(-value);
+            }
+        }
+        std::mt19937 engine(seed);
+        std::uniform_int_distribution<Raw> distribution(std::numeric_limits<Raw>::min(), std::numeric_limits<Raw>::max());
+        for (std::size_t i = 0; i < random_count; i++) {
+            operands.insert(distribution(engine));
+        }
+        return {operands.begin(), operands.end()};
+    }
+
+    std::vector<verify::Check> all_checks(Domain domain, const std::vector<Raw>& rhs) {
+        std::vector<Raw> divisors;
+        for (Raw divisor : rhs) {
+            if (divisor != 0) { divisors.push_back(divisor); }
+        }
+        return {
+            unary("sqrt", domain, [](Raw raw) {
+                return compare("sqrt(%" PRId32 ") = %" PRId32 ", expected %" PRId32, unmoving::sqrt(PSXFixed(raw)), reference_sqrt(raw), raw);
+            }),
+            unary("rsqrt", domain, [](Raw raw) {
+                return compare("rsqrt(%" PRId32 ") = %" PRId32 ", expected %" PRId32, unmoving::rsqrt(PSXFixed(raw)), reference_rsqrt(raw), raw);
+            }),
+            unary("double-round-trip", domain, [](Raw raw) {
+                return compare("PSXFixed((double)%" PRId32 ") = %" PRId32 ", expected %" PRId32, PSXFixed((double)PSXFixed(raw)), raw, raw);
+            }),
+            unary("text-round-trip", domain, [](Raw raw) {
+                char buffer[16] = {};
+                char* end = PSXFixed(raw).to_shortest_chars(buffer, buffer + sizeof(buffer)).ptr;
+                PSXFixed parsed;
+                PSXFixed::from_chars(buffer, end, parsed);
+                return compare("from_chars(to_shortest_chars(%" PRId32 ")) = %" PRId32 ", expected %" PRId32, parsed, raw, raw);
+            }),
+            binary("multiply", domain, rhs, [](Raw lhs, Raw rhs) {
+                return compare(
+                    "multiply_shift_narrow(%" PRId32 ", %" PRId32 ") = %" PRId32 ", expected %" PRId32,
+                    detail::multiply_shift_narrow(lhs, rhs, PSXFixed::FRACTION_BITS),
+                    detail::multiply_shift_wide(lhs, rhs, PSXFixed::FRACTION_BITS),
+                    lhs, rhs
+                );
+            }),
+            binary("divide", domain, divisors, [](Raw lhs, Raw rhs) {
+                return compare(
+                    "divide_shift_narrow(%" PRId32 ", %" PRId32 ") = %" PRId32 ", expected %" PRId32,
+                    detail::divide_shift_narrow(lhs, rhs, PSXFixed::FRACTION_BITS),
+                    detail::divide_shift_wide(lhs, rhs, PSXFixed::FRACTION_BITS),
+                    lhs, rhs
+                );
+            }),
+        };
+    }
+
+    // a raw value in decimal or hexadecimal, or false if it isn't one
+    bool parse_raw(const std::string& text, Raw& value) {
+        char* end = nullptr;
+        long long parsed = std::strtoll(text.c_str(), &end, 0);
+        if (text.empty() or *end != '\0') { return false; }
+        if (parsed < std::numeric_limits<Raw>::min() or parsed > std::numeric_limits<Raw>::max()) { return false; }
+        value = (Raw)parsed;
+        return true;
+    }
+
+    int usage() {
+        std::fputs(
+            "usage: verify [--list] [--threads N] [--lhs FIRST:LAST] [--rhs-random N] [--seed N]\n"
+            "              [--keep-going] [--quiet] [check...]\n",
+            stderr
+        );
+        return EXIT_FAILURE;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    verify::Options options;
+    Domain domain = {std::numeric_limits<Raw>::min(), std::numeric_limits<Raw>::max()};
+    std::size_t random_count = 16;
+    unsigned seed = 0;
+    bool list = false;
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; i++) {
+        std::string_view argument = argv[i];
+        bool has_value = i + 1 < argc;
+        if (argument == "--list") {
+            list = true;
+        } else if (argument == "--keep-going") {
+            options.keep_going = true;
+        } else if (argument == "--quiet") {
+            options.progress = false;
+        } else if (argument == "--threads" and has_value) {
+            options.threads = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "--rhs-random" and has_value) {
+            random_count = std::strtoul(argv[++i], nullptr, 10);
+        } else if (argument == "--seed" and has_value) {
+            seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        } else if (argument == "--lhs" and has_value) {
+            std::string range = argv[++i];
+            std::size_t colon = range.find(':', 1);
+            if (
+                colon == std::string::npos
+                or not parse_raw(range.substr(0, colon), domain.first)
+                or not parse_raw(range.substr(colon + 1), domain.last)
+                or domain.first > domain.last
+            ) {
+                return usage();
+            }
+        } else if (argument.starts_with("--")) {
+            return usage();
+        } else {
+            names.emplace_back(argument);
+        }
+    }
+
+    std::vector<verify::Check> checks = all_checks(domain, structured_operands(random_count, seed));
+    if (list) {
+        for (const auto& check : checks) {
+            std::puts(check.name.c_str());
+        }
+        return EXIT_SUCCESS;
+    }
+    // only the unary checks by default, as the binary ones take much longer
+    if (names.empty()) {
+        names = {"sqrt", "rsqrt", "double-round-trip", "text-round-trip"};
+    }
+
+    bool passed = true;
+    for (const auto& name : names) {
+        const verify::Check* check = nullptr;
+        for (const auto& candidate : checks) {
+            if (candidate.name == name) { check = &candidate; }
+        }
+        if (check == nullptr) {
+            std::fprintf(stderr, "unknown check: %s\n", name.c_str());
+            return EXIT_FAILURE;
+        }
+        verify::Result result = verify::run(*check, options);
+        if (result.first) {
+            passed = false;
+            std::printf(
+                "%s: FAILED, %" PRIu64 " mismatch%s%s, first at index %" PRIu64 ": %s\n",
+                name.c_str(), result.mismatches, result.mismatches == 1 ? "" : "es",
+                options.keep_going ? "" : " (stopped early)",
+                result.first->index, result.first->description.c_str()
+            );
+        } else {
+            std::printf("%s: passed, %" PRIu64 " cases checked in %.1fs\n", name.c_str(), result.checked, result.seconds);
+        }
+        std::fflush(stdout);
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
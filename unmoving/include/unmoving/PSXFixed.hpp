@@ -34,125 +34,1196 @@
 // NOTE: this C header is specific to the PSX SDK
 #include <sys/types.h> // int32, size_t
 #endif
-/*
- * get other symbols from the C headers as these are guaranteed to exist both in
- * C++ and the PSX SDK
+/**
+ * @def UNMOVING_USE_INT64
+ * @brief Whether 64-bit integer arithmetic may be used for intermediate results
+ * @details When this is `1`, multiplication and division between two PSXFixed
+ * instances widen their operands to `int64_t`. When this is `0`, they instead
+ * use routines which only ever operate on 32-bit integers, which produce
+ * bit-identical results. The PlayStation has no native 64-bit integers, so the
+ * compiler would otherwise emulate them by calling into slow libgcc helpers.
+ * @note Defaults to `1` on hosted builds and `0` on freestanding builds (such
+ * as the PlayStation). Define it before including this header to override.
  */
-#include <stdio.h>  // snprintf
-#include <stdlib.h> // abs
+#ifndef UNMOVING_USE_INT64
+#if __STDC_HOSTED__
+#define UNMOVING_USE_INT64 1
+#else
+#define UNMOVING_USE_INT64 0
+#endif
+#endif
+
+/**
+ * @def UNMOVING_CONSTEVAL_FLOAT
+ * @brief Whether conversions between Fixed and floating point may only be
+ * done at compile-time
+ * @details When this is `1`, Fixed::Fixed(double) and the cast operators to
+ * `double` and `float` are `consteval`, so that any use of them which the
+ * compiler can't fold to a constant fails to compile, rather than quietly
+ * pulling in software floating point. Use Fixed::from_ratio(),
+ * Fixed::from_float_bits() or Fixed::from_integer() at runtime instead.
+ * @note Defaults to `0`. Define it before including this header to override.
+ * The float conversions of batch.hpp aren't available when this is `1`.
+ */
+#ifndef UNMOVING_CONSTEVAL_FLOAT
+#define UNMOVING_CONSTEVAL_FLOAT 0
+#endif
+
+// declaration specifier for the conversions between Fixed and floating point
+#if UNMOVING_CONSTEVAL_FLOAT
+#define UNMOVING_FLOAT_CONSTEXPR consteval
+#else
+#define UNMOVING_FLOAT_CONSTEXPR constexpr
+#endif
 
 namespace unmoving {
-    class PSXFixed; // forward-declaration to allow declaration of user-defined literals
+    /*
+     * implementation details which are not part of the public interface, but
+     * which are accessible so that the test suite can check them against each
+     * other
+     */
+    namespace detail {
+        // properties of the integer types which Fixed can be stored as
+        template <typename T>
+        struct IntegerTraits;
+
+        template <>
+        struct IntegerTraits<int8_t> {
+            static constexpr size_t BITS = 8;
+            static constexpr bool IS_SIGNED = true;
+            static constexpr int8_t MIN = -128;
+            static constexpr int8_t MAX = 127;
+            // type which products and quotients are computed in
+            using Promoted = int32_t;
+        };
+
+        template <>
+        struct IntegerTraits<uint8_t> {
+            static constexpr size_t BITS = 8;
+            static constexpr bool IS_SIGNED = false;
+            static constexpr uint8_t MIN = 0;
+            static constexpr uint8_t MAX = 255;
+            // type which products and quotients are computed in
+            using Promoted = uint32_t;
+        };
+
+        template <>
+        struct IntegerTraits<int16_t> {
+            static constexpr size_t BITS = 16;
+            static constexpr bool IS_SIGNED = true;
+            static constexpr int16_t MIN = -32768;
+            static constexpr int16_t MAX = 32767;
+            // type which products and quotients are computed in
+            using Promoted = int32_t;
+        };
+
+        template <>
+        struct IntegerTraits<uint16_t> {
+            static constexpr size_t BITS = 16;
+            static constexpr bool IS_SIGNED = false;
+            static constexpr uint16_t MIN = 0;
+            static constexpr uint16_t MAX = 65535;
+            // type which products and quotients are computed in
+            using Promoted = uint32_t;
+        };
+
+        template <>
+        struct IntegerTraits<int32_t> {
+            static constexpr size_t BITS = 32;
+            static constexpr bool IS_SIGNED = true;
+            static constexpr int32_t MIN = -2147483647 - 1;
+            static constexpr int32_t MAX = 2147483647;
+            // type which products and quotients are computed in
+            using Promoted = int32_t;
+        };
+
+        template <>
+        struct IntegerTraits<uint32_t> {
+            static constexpr size_t BITS = 32;
+            static constexpr bool IS_SIGNED = false;
+            static constexpr uint32_t MIN = 0;
+            static constexpr uint32_t MAX = 4294967295u;
+            // type which products and quotients are computed in
+            using Promoted = uint32_t;
+        };
+
+        // a 64-bit unsigned integer, split into two 32-bit halves
+        struct DoubleWord {
+            uint32_t hi;
+            uint32_t lo;
+        };
+
+        // magnitude of a 32-bit signed integer, which can always be represented unsigned
+        constexpr uint32_t magnitude(int32_t value) {
+            return value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+        }
+
+        // magnitude of a 32-bit unsigned integer, which is just itself
+        constexpr uint32_t magnitude(uint32_t value) {
+            return value;
+        }
+
+        // number of zero bits above the most significant set bit (32 if value is zero)
+        constexpr size_t count_leading_zeros(uint32_t value) {
+            if (value == 0) { return 32; }
+            size_t count = 0;
+            // binary search, as MIPS I has no count-leading-zeroes instruction
+            if ((value >> 16) == 0) { count += 16; value <<= 16; }
+            if ((value >> 24) == 0) { count += 8; value <<= 8; }
+            if ((value >> 28) == 0) { count += 4; value <<= 4; }
+            if ((value >> 30) == 0) { count += 2; value <<= 2; }
+            if ((value >> 31) == 0) { count += 1; }
+            return count;
+        }
+
+        // low 32 bits of a 64-bit value shifted right, shift must be in the range [1..63]
+        constexpr uint32_t shift_right(DoubleWord value, size_t shift) {
+            if (shift >= 32) { return value.hi >> (shift - 32); }
+            return (value.hi << (32 - shift)) | (value.lo >> shift);
+        }
+
+        /*
+         * full 64-bit product of two unsigned 32-bit integers
+         * NOTE: a 32-by-32-bit widening multiply, which GCC compiles to a
+         * single MULTU on MIPS I rather than calling __muldi3
+         */
+        constexpr DoubleWord multiply_u32(uint32_t lhs, uint32_t rhs) {
+            uint64_t product = (uint64_t)lhs * rhs;
+            return {(uint32_t)(product >> 32), (uint32_t)product};
+        }
+
+        /*
+         * dividend / divisor, where the quotient fits in 32 bits (that is,
+         * dividend.hi < divisor), using only 32-bit arithmetic
+         * NOTE: this is the two-digit long division from Hacker's Delight (divlu)
+         */
+        constexpr uint32_t divide_u64_u32(DoubleWord dividend, uint32_t divisor, uint32_t& remainder) {
+            // normalise the divisor so that its top bit is set, which keeps the digit estimates close
+            size_t shift = count_leading_zeros(divisor);
+            divisor <<= shift;
+            uint32_t divisor_hi = divisor >> 16, divisor_lo = divisor & 0xFFFF;
+            uint32_t upper = shift == 0 ? dividend.hi : (dividend.hi << shift) | (dividend.lo >> (32 - shift));
+            uint32_t lower = dividend.lo << shift;
+            uint32_t lower_hi = lower >> 16, lower_lo = lower & 0xFFFF;
+            // estimate the high 16-bit digit of the quotient, then correct it (at most twice)
+            uint32_t quotient_hi = upper / divisor_hi;
+            uint32_t estimate_remainder = upper - quotient_hi * divisor_hi;
+            while (quotient_hi > 0xFFFF or quotient_hi * divisor_lo > ((estimate_remainder << 16) | lower_hi)) {
+                quotient_hi--;
+                estimate_remainder += divisor_hi;
+                if (estimate_remainder > 0xFFFF) { break; }
+            }
+            uint32_t middle = (upper << 16) + lower_hi - quotient_hi * divisor;
+            // and the same again for the low digit
+            uint32_t quotient_lo = middle / divisor_hi;
+            estimate_remainder = middle - quotient_lo * divisor_hi;
+            while (quotient_lo > 0xFFFF or quotient_lo * divisor_lo > ((estimate_remainder << 16) | lower_lo)) {
+                quotient_lo--;
+                estimate_remainder += divisor_hi;
+                if (estimate_remainder > 0xFFFF) { break; }
+            }
+            remainder = ((middle << 16) + lower_lo - quotient_lo * divisor) >> shift;
+            return (quotient_hi << 16) | quotient_lo;
+        }
+
+        /*
+         * (lhs * rhs) / 2**shift, rounded towards zero and wrapped to 32 bits,
+         * using 64-bit intermediate arithmetic
+         * NOTE: shift must be in the range [1..31]
+         */
+        constexpr int32_t multiply_shift_wide(int32_t lhs, int32_t rhs, size_t shift) {
+            int64_t result = (int64_t)lhs * rhs;
+            return (int32_t)(result / ((int64_t)1 << shift));
+        }
+
+        constexpr uint32_t multiply_shift_wide(uint32_t lhs, uint32_t rhs, size_t shift) {
+            return (uint32_t)(((uint64_t)lhs * rhs) >> shift);
+        }
+
+        /*
+         * (lhs * rhs) / 2**shift, rounded towards zero and wrapped to 32 bits,
+         * using only 32-bit arithmetic
+         * NOTE: shift must be in the range [1..31]
+         */
+        constexpr uint32_t multiply_shift_narrow(uint32_t lhs, uint32_t rhs, size_t shift) {
+            return shift_right(multiply_u32(lhs, rhs), shift);
+        }
+
+        constexpr int32_t multiply_shift_narrow(int32_t lhs, int32_t rhs, size_t shift) {
+            // rounding the magnitude down is the same as rounding the result towards zero
+            uint32_t result = multiply_shift_narrow(magnitude(lhs), magnitude(rhs), shift);
+            return (int32_t)((lhs < 0) != (rhs < 0) ? 0u - result : result);
+        }
+
+        /*
+         * (lhs * 2**shift) / rhs, rounded towards zero and wrapped to 32 bits,
+         * using 64-bit intermediate arithmetic
+         * NOTE: shift must be in the range [1..31]
+         */
+        constexpr int32_t divide_shift_wide(int32_t lhs, int32_t rhs, size_t shift) {
+            int64_t scaled = (int64_t)lhs * ((int64_t)1 << shift);
+            return (int32_t)(scaled / rhs);
+        }
+
+        constexpr uint32_t divide_shift_wide(uint32_t lhs, uint32_t rhs, size_t shift) {
+            return (uint32_t)(((uint64_t)lhs << shift) / rhs);
+        }
+
+        /*
+         * (lhs * 2**shift) / rhs, rounded towards zero and wrapped to 32 bits,
+         * using only 32-bit arithmetic
+         * NOTE: shift must be in the range [1..31]
+         */
+        constexpr uint32_t divide_shift_narrow(uint32_t lhs, uint32_t rhs, size_t shift) {
+            // the integer part of the quotient can be had with a native division
+            uint32_t quotient = lhs / rhs;
+            uint32_t remainder = lhs % rhs;
+            if ((remainder >> (32 - shift)) == 0) {
+                // the remainder can be scaled up without overflow, so use a second native division for the rest
+                return (quotient << shift) + (remainder << shift) / rhs;
+            }
+            // otherwise, long-divide the remaining bits one at a time
+            for (size_t i = 0; i < shift; i++) {
+                bool carry = (remainder >> 31) != 0;
+                remainder <<= 1;
+                quotient <<= 1;
+                if (carry or remainder >= rhs) {
+                    remainder -= rhs;
+                    quotient |= 1;
+                }
+            }
+            return quotient;
+        }
+
+        constexpr int32_t divide_shift_narrow(int32_t lhs, int32_t rhs, size_t shift) {
+            // rounding the magnitude down is the same as rounding the result towards zero
+            uint32_t quotient = divide_shift_narrow(magnitude(lhs), magnitude(rhs), shift);
+            return (int32_t)((lhs < 0) != (rhs < 0) ? 0u - quotient : quotient);
+        }
+
+        // whether value is below zero, without warning about it never being so when T is unsigned
+        template <typename T>
+        constexpr bool is_negative(T value) {
+            if constexpr (IntegerTraits<T>::IS_SIGNED) {
+                return value < 0;
+            } else {
+                (void)value;
+                return false;
+            }
+        }
+
+        /*
+         * (lhs * rhs) / 2**shift for any type Fixed can be stored as, rounded
+         * towards zero and wrapped to the size of T
+         */
+        template <typename T>
+        constexpr T multiply_shift(T lhs, T rhs, size_t shift) {
+            using Promoted = typename IntegerTraits<T>::Promoted;
+            if constexpr (IntegerTraits<T>::BITS <= 16) {
+                // the product of two 16-bit integers always fits in 32 bits, so no widening is needed
+                return (T)(((Promoted)lhs * (Promoted)rhs) / ((Promoted)1 << shift));
+            } else {
+#if UNMOVING_USE_INT64
+                return multiply_shift_wide(lhs, rhs, shift);
+#else
+                // no int64_t on PS1, so avoid the software emulation that would kick in
+                return multiply_shift_narrow(lhs, rhs, shift);
+#endif
+            }
+        }
+
+        /*
+         * (lhs * 2**shift) / rhs for any type Fixed can be stored as, rounded
+         * towards zero and wrapped to the size of T
+         */
+        template <typename T>
+        constexpr T divide_shift(T lhs, T rhs, size_t shift) {
+            using Promoted = typename IntegerTraits<T>::Promoted;
+            if constexpr (IntegerTraits<T>::BITS <= 16) {
+                // a 16-bit integer scaled by its own fraction bits always fits in 32 bits
+                return (T)(((Promoted)lhs * ((Promoted)1 << shift)) / (Promoted)rhs);
+            } else {
+#if UNMOVING_USE_INT64
+                return divide_shift_wide(lhs, rhs, shift);
+#else
+                // no int64_t on PS1, so avoid the 64-by-32 software division that would kick in
+                return divide_shift_narrow(lhs, rhs, shift);
+#endif
+            }
+        }
+
+        // an IEEE-754 number, split into (-1)**negative * significand * 2**exponent
+        struct FloatParts {
+            bool negative;
+            DoubleWord significand;
+            int32_t exponent;
+        };
+
+        /*
+         * splits the bits of an IEEE-754 single-precision float into its parts
+         * NOTE: infinities become values too large for any Fixed and NaNs become zero
+         */
+        constexpr FloatParts float_parts(uint32_t bits) {
+            bool negative = (bits >> 31) != 0;
+            uint32_t biased_exponent = (bits >> 23) & 0xFFu;
+            uint32_t fraction = bits & 0x7FFFFFu;
+            if (biased_exponent == 0xFFu) {
+                return {negative, {0, fraction == 0 ? 1u : 0u}, 1024};
+            }
+            // subnormals have the same exponent as the smallest normal ones, but no implicit leading one
+            if (biased_exponent == 0) {
+                return {negative, {0, fraction}, 1 - 150};
+            }
+            return {negative, {0, fraction | 0x800000u}, (int32_t)biased_exponent - 150};
+        }
+
+        // the same as float_parts() but for IEEE-754 double-precision floats
+        constexpr FloatParts double_parts(uint64_t bits) {
+            uint32_t hi = (uint32_t)(bits >> 32);
+            uint32_t lo = (uint32_t)bits;
+            bool negative = (hi >> 31) != 0;
+            uint32_t biased_exponent = (hi >> 20) & 0x7FFu;
+            uint32_t fraction = hi & 0xFFFFFu;
+            if (biased_exponent == 0x7FFu) {
+                return {negative, {0, fraction == 0 and lo == 0 ? 1u : 0u}, 1024};
+            }
+            if (biased_exponent == 0) {
+                return {negative, {fraction, lo}, 1 - 1075};
+            }
+            return {negative, {fraction | 0x100000u, lo}, (int32_t)biased_exponent - 1075};
+        }
+
+        /*
+         * splits significand * 2**exponent into the whole part and whether the
+         * rest is at least a half, or returns false if the whole part doesn't
+         * fit in 32 bits
+         */
+        constexpr bool split_scaled(DoubleWord significand, int32_t exponent, uint32_t& whole, bool& half) {
+            whole = 0;
+            half = false;
+            if (significand.hi == 0 and significand.lo == 0) { return true; }
+            if (exponent >= 0) {
+                if (exponent >= 32 or significand.hi != 0 or ((significand.lo >> (31 - exponent)) >> 1) != 0) {
+                    return false;
+                }
+                whole = significand.lo << exponent;
+                return true;
+            }
+            size_t shift = (size_t)-(int64_t)exponent;
+            // shifted so far that not even the half is left
+            if (shift > 64) { return true; }
+            uint32_t highest_shifted_out = shift <= 32 ? significand.lo >> (shift - 1) : significand.hi >> (shift - 33);
+            half = (highest_shifted_out & 1u) != 0;
+            if (shift < 64) {
+                if (shift < 32 and (significand.hi >> shift) != 0) { return false; }
+                whole = shift_right(significand, shift);
+            }
+            return true;
+        }
+
+        // number of decimal digits needed to print value
+        constexpr size_t count_digits(uint32_t value) {
+            size_t digits = 1;
+            while (value >= 10) {
+                value /= 10;
+                digits++;
+            }
+            return digits;
+        }
+
+        // "00" to "99", for writing decimal digits two at a time
+        inline constexpr char DIGIT_PAIRS[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        /*
+         * writes the last count decimal digits of value, ending just before end
+         * NOTE: the divisions are by constants, so they are done with multiplications
+         */
+        constexpr void write_digits(char* end, uint32_t value, size_t count) {
+            for (; count >= 2; count -= 2) {
+                uint32_t pair = value % 100;
+                value /= 100;
+                *--end = DIGIT_PAIRS[2 * pair + 1];
+                *--end = DIGIT_PAIRS[2 * pair];
+            }
+            if (count == 1) {
+                *--end = (char)('0' + value % 10);
+            }
+        }
+
+        /*
+         * multiplies fraction / 2**bits by ten, returning the whole part and
+         * leaving the rest as fraction / 2**(bits - 1)
+         * NOTE: only uses 32-bit arithmetic, for any bits in the range [1..32]
+         */
+        constexpr uint32_t next_decimal_digit(uint32_t& fraction, size_t& bits) {
+            // fraction * 10 / 2**bits == fraction * 5 / 2**(bits - 1)
+            if (bits <= 29) {
+                uint32_t product = fraction * 5;
+                bits--;
+                fraction = product & (((uint32_t)1 << bits) - 1);
+                return product >> bits;
+            }
+            // multiply the top two bits separately, so that the product can't overflow
+            uint32_t low = (fraction & (((uint32_t)1 << (bits - 2)) - 1)) * 5;
+            uint32_t high = (fraction >> (bits - 2)) * 5 + (low >> (bits - 2));
+            bits--;
+            fraction = ((high & 1) << (bits - 1)) | (low & (((uint32_t)1 << (bits - 1)) - 1));
+            return high >> 1;
+        }
+
+        constexpr bool is_digit(char character) {
+            return character >= '0' and character <= '9';
+        }
+
+        /*
+         * floor(0.d1d2d3... * 2**bits) for the count decimal digits, setting
+         * round_up to whether the rest is at least a half
+         * NOTE: digits are overwritten, and bits must be in the range [1..32]
+         */
+        constexpr uint32_t scale_decimal_fraction(uint8_t* digits, size_t count, size_t bits, bool& round_up) {
+            uint32_t result = 0;
+            // multiply by 2**28 at most at a time, so that the products fit in 32 bits
+            while (bits != 0) {
+                size_t shift = bits < 28 ? bits : 28;
+                bits -= shift;
+                // long multiplication from the last digit, where the carry out is the whole part
+                uint32_t carry = 0;
+                for (size_t i = count; i-- > 0; ) {
+                    uint32_t product = ((uint32_t)digits[i] << shift) + carry;
+                    digits[i] = (uint8_t)(product % 10);
+                    carry = product / 10;
+                }
+                result = (result << shift) + carry;
+            }
+            round_up = digits[0] >= 5;
+            return result;
+        }
+
+        /*
+         * writes the sign, the whole part, and the fraction digits followed by
+         * zeros more zeros, if there are any, to [first, last)
+         * returns the end of what was written, or nullptr if there isn't room
+         */
+        constexpr char* write_decimal(
+            char* first,
+            char* last,
+            bool negative,
+            uint32_t whole,
+            const char* digits,
+            size_t count,
+            size_t zeros
+        ) {
+            size_t whole_digits = count_digits(whole);
+            size_t fraction_digits = count + zeros;
+            size_t length = (negative ? 1 : 0) + whole_digits + (fraction_digits != 0 ? 1 + fraction_digits : 0);
+            if ((size_t)(last - first) < length) { return nullptr; }
+            if (negative) { *first++ = '-'; }
+            first += whole_digits;
+            write_digits(first, whole, whole_digits);
+            if (fraction_digits != 0) {
+                *first++ = '.';
+                for (size_t i = 0; i < count; i++) { *first++ = digits[i]; }
+                for (size_t i = 0; i < zeros; i++) { *first++ = '0'; }
+            }
+            return first;
+        }
+
+        // a 64-bit two's complement integer, for sums of full products
+#if UNMOVING_USE_INT64
+        using Wide = uint64_t;
+#else
+        // no int64_t on PS1, so avoid the software emulation that would kick in
+        using Wide = DoubleWord;
+#endif
+
+        // lhs + rhs, wrapped to 64 bits
+        constexpr Wide wide_add(Wide lhs, Wide rhs) {
+#if UNMOVING_USE_INT64
+            return lhs + rhs;
+#else
+            uint32_t lo = lhs.lo + rhs.lo;
+            return {lhs.hi + rhs.hi + (lo < lhs.lo ? 1u : 0u), lo};
+#endif
+        }
+
+        // -value, wrapped to 64 bits
+        constexpr Wide wide_negate(Wide value) {
+#if UNMOVING_USE_INT64
+            return 0u - value;
+#else
+            return {~value.hi + (value.lo == 0 ? 1u : 0u), 0u - value.lo};
+#endif
+        }
+
+        // full product of two values of any type Fixed can be stored as
+        template <typename T>
+        constexpr Wide wide_product(T lhs, T rhs) {
+            using Promoted = typename IntegerTraits<T>::Promoted;
+            if constexpr (IntegerTraits<T>::BITS <= 16) {
+                // the product of two 16-bit integers always fits in 32 bits, so only needs extending to 64
+                Promoted product = (Promoted)lhs * (Promoted)rhs;
+#if UNMOVING_USE_INT64
+                return (Wide)(int64_t)product;
+#else
+                return {is_negative(product) ? 0xFFFFFFFFu : 0u, (uint32_t)product};
+#endif
+            } else {
+#if UNMOVING_USE_INT64
+                if constexpr (IntegerTraits<T>::IS_SIGNED) {
+                    return (Wide)((int64_t)lhs * rhs);
+                } else {
+                    return (Wide)lhs * rhs;
+                }
+#else
+                Wide product = multiply_u32(magnitude(lhs), magnitude(rhs));
+                return is_negative(lhs) != is_negative(rhs) ? wide_negate(product) : product;
+#endif
+            }
+        }
+
+        /*
+         * value / 2**shift, rounded towards zero if T is signed (and down if
+         * it isn't), wrapped to the size of T
+         * NOTE: shift must be in the range [1..31]
+         */
+        template <typename T>
+        constexpr T wide_shift(Wide value, size_t shift) {
+#if UNMOVING_USE_INT64
+            bool negative = IntegerTraits<T>::IS_SIGNED and (value >> 63) != 0;
+            uint32_t result = (uint32_t)((negative ? wide_negate(value) : value) >> shift);
+#else
+            bool negative = IntegerTraits<T>::IS_SIGNED and (value.hi >> 31) != 0;
+            uint32_t result = shift_right(negative ? wide_negate(value) : value, shift);
+#endif
+            // rounding the magnitude down is the same as rounding the result towards zero
+            return (T)(negative ? 0u - result : result);
+        }
+
+        /*
+         * (lhs * rhs) / divisor, rounded to nearest with ties away from zero,
+         * from the full 64-bit product
+         * returns false (leaving result alone) if the result is more than limit
+         */
+        constexpr bool multiply_divide_u32(uint32_t lhs, uint32_t rhs, uint32_t divisor, uint32_t limit, uint32_t& result) {
+#if UNMOVING_USE_INT64
+            uint64_t product = (uint64_t)lhs * rhs;
+            uint64_t remainder = product % divisor;
+            uint64_t quotient = product / divisor + (remainder >= divisor - remainder ? 1u : 0u);
+            if (quotient > limit) { return false; }
+            result = (uint32_t)quotient;
+            return true;
+#else
+            DoubleWord product = multiply_u32(lhs, rhs);
+            // otherwise, the quotient doesn't even fit in 32 bits
+            if (product.hi >= divisor) { return false; }
+            uint32_t remainder = 0;
+            uint32_t quotient = divide_u64_u32(product, divisor, remainder);
+            bool round_up = remainder >= divisor - remainder;
+            if (quotient > limit or (round_up and quotient == limit)) { return false; }
+            result = quotient + (round_up ? 1u : 0u);
+            return true;
+#endif
+        }
+
+        /*
+         * (lhs * rhs) / 2**shift, rounded to nearest with ties away from zero,
+         * from the full 64-bit product
+         * returns false (leaving result alone) if the result is more than limit
+         * NOTE: shift must be in the range [1..63]
+         */
+        constexpr bool multiply_shift_round_u32(uint32_t lhs, uint32_t rhs, size_t shift, uint32_t limit, uint32_t& result) {
+#if UNMOVING_USE_INT64
+            uint64_t product = (uint64_t)lhs * rhs;
+            // the highest bit shifted out decides the rounding
+            uint64_t quotient = (product >> shift) + ((product >> (shift - 1)) & 1u);
+            if (quotient > limit) { return false; }
+            result = (uint32_t)quotient;
+            return true;
+#else
+            DoubleWord product = multiply_u32(lhs, rhs);
+            // otherwise, the quotient doesn't even fit in 32 bits
+            if (shift < 32 and (product.hi >> shift) != 0) { return false; }
+            uint32_t quotient = shift_right(product, shift);
+            // the highest bit shifted out decides the rounding
+            bool round_up = ((shift <= 32 ? product.lo >> (shift - 1) : product.hi >> (shift - 33)) & 1u) != 0;
+            if (quotient > limit or (round_up and quotient == limit)) { return false; }
+            result = quotient + (round_up ? 1u : 0u);
+            return true;
+#endif
+        }
+
+        /*
+         * (lhs * rhs) / divisor for any type Fixed can be stored as, rounded
+         * to nearest with ties away from zero
+         * sets overflow and saturates if the result is out of the range of T,
+         * which includes when divisor is zero
+         */
+        template <typename T>
+        constexpr T multiply_divide(T lhs, T rhs, T divisor, bool& overflow) {
+            using Promoted = typename IntegerTraits<T>::Promoted;
+            bool negative = (is_negative(lhs) != is_negative(rhs)) != is_negative(divisor);
+            uint32_t limit = negative ? magnitude((Promoted)IntegerTraits<T>::MIN) : (uint32_t)IntegerTraits<T>::MAX;
+            uint32_t lhs_magnitude = magnitude((Promoted)lhs), rhs_magnitude = magnitude((Promoted)rhs);
+            uint32_t divisor_magnitude = magnitude((Promoted)divisor);
+            uint32_t result = 0;
+            if (divisor_magnitude == 0) {
+                overflow = true;
+            } else if constexpr (IntegerTraits<T>::BITS <= 16) {
+                // the product of two 16-bit magnitudes always fits in 32 bits
+                uint32_t product = lhs_magnitude * rhs_magnitude;
+                uint32_t remainder = product % divisor_magnitude;
+                result = product / divisor_magnitude + (remainder >= divisor_magnitude - remainder ? 1u : 0u);
+                overflow = result > limit;
+            } else {
+                overflow = not multiply_divide_u32(lhs_magnitude, rhs_magnitude, divisor_magnitude, limit, result);
+            }
+            if (overflow) {
+                return negative ? IntegerTraits<T>::MIN : IntegerTraits<T>::MAX;
+            }
+            return (T)(negative ? 0u - result : result);
+        }
+
+        /*
+         * (lhs * rhs) / 2**shift for any type Fixed can be stored as, rounded
+         * to nearest with ties away from zero
+         * sets overflow and saturates if the result is out of the range of T
+         * NOTE: shift must be in the range [1..63]
+         */
+        template <typename T>
+        constexpr T multiply_shift_rounded(T lhs, T rhs, size_t shift, bool& overflow) {
+            using Promoted = typename IntegerTraits<T>::Promoted;
+            bool negative = is_negative(lhs) != is_negative(rhs);
+            uint32_t limit = negative ? magnitude((Promoted)IntegerTraits<T>::MIN) : (uint32_t)IntegerTraits<T>::MAX;
+            uint32_t result = 0;
+            overflow = not multiply_shift_round_u32(magnitude((Promoted)lhs), magnitude((Promoted)rhs), shift, limit, result);
+            if (overflow) {
+                return negative ? IntegerTraits<T>::MIN : IntegerTraits<T>::MAX;
+            }
+            return (T)(negative ? 0u - result : result);
+        }
+
+        // lookup table of initial estimates for reciprocal_u32()
+        struct ReciprocalSeeds {
+            uint16_t values[256];
+        };
+
+        constexpr ReciprocalSeeds make_reciprocal_seeds() {
+            ReciprocalSeeds seeds = {};
+            for (uint32_t i = 0; i < 256; i++) {
+                // midpoint of the interval [0.5 + i / 512, 0.5 + (i + 1) / 512), in 1024ths
+                uint32_t midpoint = 512 + 2 * i + 1;
+                // reciprocal of the midpoint, with its leading 1 removed, as a 0.16 fraction
+                seeds.values[i] = (uint16_t)((((1u << 26) + midpoint / 2) / midpoint) - (1u << 16));
+            }
+            return seeds;
+        }
+
+        inline constexpr ReciprocalSeeds RECIPROCAL_SEEDS = make_reciprocal_seeds();
+
+        /*
+         * ceil(2**63 / divisor), using only 32-bit arithmetic
+         * NOTE: divisor must be normalised (top bit set) and not be 2**31
+         */
+        constexpr uint32_t reciprocal_u32(uint32_t divisor) {
+            // 8-bit accurate seed from the table, indexed by the bits below the leading 1
+            uint32_t estimate = 0x80000000u + ((uint32_t)RECIPROCAL_SEEDS.values[(divisor >> 23) & 0xFF] << 15);
+            // two Newton-Raphson iterations of y = y * (2 - divisor * y) in 1.31 format bring it to within a few units
+            for (size_t i = 0; i < 2; i++) {
+                uint32_t error = 0u - multiply_u32(divisor, estimate).hi;
+                DoubleWord refined = multiply_u32(estimate, error);
+                estimate = (refined.hi << 1) | (refined.lo >> 31);
+            }
+            // correct the last few units by finding the smallest estimate for which divisor * estimate >= 2**63
+            DoubleWord product = multiply_u32(divisor, estimate);
+            while (product.hi < 0x80000000u) {
+                estimate++;
+                product.lo += divisor;
+                product.hi += product.lo < divisor ? 1 : 0;
+            }
+            while (true) {
+                DoubleWord smaller = {product.hi - (product.lo < divisor ? 1u : 0u), product.lo - divisor};
+                if (smaller.hi < 0x80000000u) { break; }
+                estimate--;
+                product = smaller;
+            }
+            return estimate;
+        }
+
+        // low 32 bits of (lhs * rhs) / 2**shift, shift must be in the range [1..63]
+        constexpr uint32_t multiply_shift_u32(uint32_t lhs, uint32_t rhs, size_t shift) {
+#if UNMOVING_USE_INT64
+            return (uint32_t)(((uint64_t)lhs * rhs) >> shift);
+#else
+            return shift_right(multiply_u32(lhs, rhs), shift);
+#endif
+        }
+
+        // floor(n / divisor) == floor(n * multiplier / 2**shift) for all n <= 2**dividend_bits
+        struct MagicDivisor {
+            uint32_t multiplier;
+            size_t shift;
+        };
+
+        /*
+         * finds the multiplier and shift for dividing by divisor, which must be
+         * odd and at least 3, or returns a shift of 0 if there isn't one
+         * NOTE: this is only ever evaluated at compile-time, so may use 64-bit arithmetic
+         */
+        consteval MagicDivisor magic_divisor(uint32_t divisor, size_t dividend_bits) {
+            /*
+             * with multiplier = ceil(2**shift / divisor) and
+             * error = multiplier * divisor - 2**shift, the result is exact for
+             * all n <= 2**dividend_bits as long as error * 2**dividend_bits < 2**shift,
+             * which is always possible with a multiplier of no more than 32 bits
+             * when dividend_bits is 31
+             */
+            for (size_t shift = 32; shift < 64; shift++) {
+                uint64_t multiplier = (((uint64_t)1 << shift) + divisor - 1) / divisor;
+                if ((multiplier >> 32) != 0) { break; }
+                uint64_t error = multiplier * divisor - ((uint64_t)1 << shift);
+                if ((error << dividend_bits) < ((uint64_t)1 << shift)) {
+                    return {(uint32_t)multiplier, shift};
+                }
+            }
+            return {0, 0};
+        }
+
+        /*
+         * describes how to compute floor(n * 2**fraction_bits / divisor) for a
+         * constant divisor, as floor(((n >> pre_shift) << scale) / odd_divisor)
+         */
+        struct ConstantDivisor {
+            size_t pre_shift;
+            size_t scale;
+            uint32_t odd_divisor;
+            MagicDivisor magic;
+            bool negative;
+            // whether the division can be done with multiplications (false if the remainder can't be scaled)
+            bool use_magic;
+        };
+
+        // divisor is the magnitude of the divisor and dividends are no larger than 2**dividend_bits
+        consteval ConstantDivisor constant_divisor(
+            uint32_t divisor,
+            bool negative,
+            size_t fraction_bits,
+            size_t dividend_bits
+        ) {
+            ConstantDivisor result = {0, 0, divisor, {0, 0}, negative, true};
+            // pull the factors of two out of the divisor, cancelling them against the scale
+            size_t twos = 0;
+            while ((result.odd_divisor & 1) == 0) {
+                result.odd_divisor >>= 1;
+                twos++;
+            }
+            if (twos >= fraction_bits) {
+                result.pre_shift = twos - fraction_bits;
+            } else {
+                result.scale = fraction_bits - twos;
+            }
+            if (result.odd_divisor != 1) {
+                result.magic = magic_divisor(result.odd_divisor, dividend_bits);
+                // the remainder of the first division is scaled up and divided again, so it must stay in range
+                result.use_magic = result.magic.shift != 0
+                    and ((uint64_t)result.odd_divisor << result.scale) <= ((uint64_t)1 << dividend_bits);
+            }
+            return result;
+        }
+
+        // floor(n * 2**fraction_bits / divisor) for a constant divisor, wrapped to 32 bits
+        constexpr uint32_t divide_constant(uint32_t dividend, const ConstantDivisor& divisor) {
+            dividend >>= divisor.pre_shift;
+            if (divisor.odd_divisor == 1) {
+                return dividend << divisor.scale;
+            }
+            uint32_t quotient = multiply_shift_u32(dividend, divisor.magic.multiplier, divisor.magic.shift);
+            if (divisor.scale == 0) {
+                return quotient;
+            }
+            // divide the scaled remainder to get the fraction bits of the quotient
+            uint32_t remainder = dividend - quotient * divisor.odd_divisor;
+            return (quotient << divisor.scale) + multiply_shift_u32(
+                remainder << divisor.scale,
+                divisor.magic.multiplier,
+                divisor.magic.shift
+            );
+        }
+
+        /*
+         * describes how to compute n * multiplier / 2**fraction_bits for a
+         * constant multiplier, as (n * odd_multiplier) << post_shift or
+         * (n * odd_multiplier) >> shift
+         */
+        struct ConstantMultiplier {
+            uint32_t odd_multiplier;
+            size_t post_shift;
+            size_t shift;
+            bool negative;
+        };
+
+        // multiplier is the magnitude of the multiplier
+        consteval ConstantMultiplier constant_multiplier(uint32_t multiplier, bool negative, size_t fraction_bits) {
+            ConstantMultiplier result = {multiplier, 0, 0, negative};
+            if (result.odd_multiplier == 0) { return result; }
+            size_t twos = 0;
+            while ((result.odd_multiplier & 1) == 0) {
+                result.odd_multiplier >>= 1;
+                twos++;
+            }
+            if (twos >= fraction_bits) {
+                result.post_shift = twos - fraction_bits;
+            } else {
+                result.shift = fraction_bits - twos;
+            }
+            return result;
+        }
+
+        // n * multiplier / 2**fraction_bits for a constant multiplier, rounded down and wrapped to 32 bits
+        constexpr uint32_t multiply_constant(uint32_t multiplicand, const ConstantMultiplier& multiplier) {
+            if (multiplier.shift == 0) {
+                // an integer multiplication, which the compiler turns into shifts and adds where cheaper
+                return (multiplicand * multiplier.odd_multiplier) << multiplier.post_shift;
+            } else if (multiplier.odd_multiplier == 1) {
+                return multiplicand >> multiplier.shift;
+            }
+            return multiply_shift_u32(multiplicand, multiplier.odd_multiplier, multiplier.shift);
+        }
+
+        // the value of a numeric literal scaled to fixed-point, and whether it fits
+        struct ParsedLiteral {
+            uint32_t raw;
+            bool in_range;
+        };
+
+        // value of a digit of a numeric literal in any base
+        consteval uint32_t digit_value(char digit) {
+            if (digit >= 'a') { return (uint32_t)(digit - 'a') + 10; }
+            if (digit >= 'A') { return (uint32_t)(digit - 'A') + 10; }
+            return (uint32_t)(digit - '0');
+        }
+
+        /*
+         * literal * 2**fraction_bits, rounded to nearest with ties away from
+         * zero, from the characters of any C++ integer or floating-point
+         * literal. This is exact for literals of any length, since only the
+         * digits which decide the result are looked at.
+         * NOTE: the characters are those of a valid literal, as the compiler
+         * has already checked them
+         */
+        template <char... Literal>
+        consteval ParsedLiteral parse_literal(size_t fraction_bits, uint32_t limit) {
+            constexpr char TEXT[] = {Literal...};
+            constexpr size_t LENGTH = sizeof...(Literal);
+            // decimal, or the bits of each digit in binary, octal and hexadecimal
+            size_t bits_per_digit = 0;
+            size_t i = 0;
+            if (LENGTH > 2 and TEXT[0] == '0' and (TEXT[1] == 'x' or TEXT[1] == 'X')) {
+                bits_per_digit = 4;
+                i = 2;
+            } else if (LENGTH > 2 and TEXT[0] == '0' and (TEXT[1] == 'b' or TEXT[1] == 'B')) {
+                bits_per_digit = 1;
+                i = 2;
+            } else if (LENGTH > 1 and TEXT[0] == '0') {
+                // a leading zero means octal, unless it's the start of a decimal floating-point literal
+                bits_per_digit = 3;
+                for (char c : TEXT) {
+                    if (c == '.' or c == 'e' or c == 'E') { bits_per_digit = 0; }
+                }
+            }
+            // the significant digits, and how many of them come after the point
+            uint8_t digits[LENGTH] = {};
+            size_t count = 0;
+            int64_t fraction_digits = 0;
+            bool after_point = false;
+            for (; i < LENGTH; i++) {
+                char c = TEXT[i];
+                if (c == '\'') { continue; }
+                if (c == '.') {
+                    after_point = true;
+                } else if (bits_per_digit == 0 ? (c == 'e' or c == 'E') : (c == 'p' or c == 'P')) {
+                    break;
+                } else {
+                    // leading zeros only matter for where the point is
+                    if (count != 0 or c != '0') {
+                        digits[count++] = (uint8_t)digit_value(c);
+                    }
+                    if (after_point) { fraction_digits++; }
+                }
+            }
+            // the exponent, which is a power of ten for decimal and of two otherwise
+            int64_t exponent = 0;
+            if (i < LENGTH) {
+                bool negative = TEXT[++i] == '-';
+                if (TEXT[i] == '-' or TEXT[i] == '+') { i++; }
+                for (; i < LENGTH; i++) {
+                    // huge exponents give zero or overflow anyway, so stop them from wrapping
+                    if (TEXT[i] != '\'' and exponent < 1'000'000) {
+                        exponent = exponent * 10 + digit_value(TEXT[i]);
+                    }
+                }
+                if (negative) { exponent = -exponent; }
+            }
+            if (count == 0) { return {0, true}; }
+            if (bits_per_digit == 0) {
+                // the digits are 0.d1d2d3... * 10**point
+                int64_t point = (int64_t)count - fraction_digits + exponent;
+                // less than 10**-fraction_bits, which is less than half a step
+                if (point <= -(int64_t)fraction_bits) { return {0, true}; }
+                uint64_t whole = 0;
+                for (int64_t digit = 0; digit < point; digit++) {
+                    whole = whole * 10 + (uint64_t)((uint64_t)digit < count ? digits[digit] : 0);
+                    if (whole > limit) { return {0, false}; }
+                }
+                /*
+                 * multiply the fraction by 2**fraction_bits a digit at a time
+                 * from the end, like long multiplication: the carry out is the
+                 * fraction bits and the top digit of what's left rounds them
+                 */
+                uint64_t carry = 0;
+                uint64_t rounding_digit = 0;
+                for (int64_t digit = (int64_t)count - 1; digit >= point; digit--) {
+                    uint64_t product = (uint64_t)(digit >= 0 ? digits[digit] : 0) * ((uint64_t)1 << fraction_bits) + carry;
+                    rounding_digit = product % 10;
+                    carry = product / 10;
+                }
+                uint64_t raw = (whole << fraction_bits) + carry + (rounding_digit >= 5 ? 1 : 0);
+                return {(uint32_t)raw, raw <= limit};
+            }
+            /*
+             * the digits are a binary number scaled by a power of two, so only
+             * the first 60 bits or so are needed: if there are any more, the
+             * result either overflows or is rounded above the digits dropped
+             */
+            uint64_t mantissa = 0;
+            int64_t shift = (int64_t)fraction_bits + exponent - (int64_t)bits_per_digit * fraction_digits;
+            for (size_t digit = 0; digit < count; digit++) {
+                if ((mantissa >> 56) == 0) {
+                    mantissa = (mantissa << bits_per_digit) | digits[digit];
+                } else {
+                    shift += (int64_t)bits_per_digit;
+                }
+            }
+            if (shift >= 0) {
+                if (shift >= 32 or mantissa > ((uint64_t)limit >> shift)) { return {0, false}; }
+                return {(uint32_t)(mantissa << shift), true};
+            }
+            // shifted too far to reach half a step
+            if (shift < -64) { return {0, true}; }
+            uint64_t raw = ((mantissa >> (-shift - 1)) + 1) >> 1;
+            return {(uint32_t)raw, raw <= limit};
+        }
+    }
+
+    /**
+     * @brief The result of Fixed::to_chars()
+     */
+    struct ToCharsResult {
+        /** @brief One past the last character written, or the end of the range if it was too small */
+        char* ptr;
+        /** @brief Whether the value was written, which it isn't if the range is too small */
+        bool success;
+    };
+
+    /**
+     * @brief Why Fixed::from_chars() couldn't parse a value
+     */
+    enum class FromCharsError {
+        NONE,         ///< parsed successfully
+        INVALID,      ///< there was no number to parse
+        OUT_OF_RANGE, ///< the number is out of range of the Fixed type
+    };
 
     /**
-     * @brief User-defined literal for PSXFixed objects with fractional parts
+     * @brief The result of Fixed::from_chars()
+     */
+    struct FromCharsResult {
+        /** @brief One past the last character of the number, or the start of the range if there wasn't one */
+        const char* ptr;
+        /** @brief What went wrong, if anything */
+        FromCharsError error;
+    };
+
+    template <size_t IntBits, size_t FracBits, typename Storage>
+    class Fixed; // forward-declaration to allow declaration of PSXFixed
+
+    /**
+     * @brief Fixed-point arithmetic value type for Sony PlayStation
+     * @details The `Q19.12` fixed-point format used by the PSX standard
+     * library, stored in the native 32-bit integers used on the platform.
+     * @see Fixed
+     */
+    using PSXFixed = Fixed<19, 12, int32_t>;
+
+    /**
+     * @brief Compact fixed-point arithmetic value type for Sony PlayStation
+     * @details The `1.3.12` fixed-point format used by the GTE for vectors
+     * and matrices (`SVECTOR` and `MATRIX`), stored in 16-bit integers so
+     * that large arrays of them take half the memory of PSXFixed. All of its
+     * arithmetic is done in 32-bit registers.
+     * @note It converts to PSXFixed implicitly, which costs only a
+     * sign-extension, but must be converted explicitly to be used in
+     * arithmetic with PSXFixed. Converting from PSXFixed must be done
+     * explicitly, or with Fixed::saturate() to clamp values which are out of range.
+     * @see Fixed
+     */
+    using PSXFixed16 = Fixed<3, 12, int16_t>;
+
+    /**
+     * @brief User-defined literal for PSXFixed objects
+     * @details The digits of the literal are parsed exactly at compile-time,
+     * and rounded to the nearest PSXFixed value (with ties rounded away from
+     * zero), so no floating point is involved and the result is the same with
+     * every compiler. Any form of integer or floating-point literal can be
+     * used, including exponents and hexadecimal. Literals too large for
+     * PSXFixed fail to compile.
      *
      * @b Usage:
      * @code
      * PSXFixed full = 123.45_fx;
      * PSXFixed fractional = .45_fx;
+     * PSXFixed integral = 123_fx;
+     * PSXFixed small = 1.5e-3_fx;
+     * PSXFixed eighth = 0x1p-3_fx;
      * @endcode
+     * @warning Use this to initialise PSXFixed objects when the intention is
+     * to hold the same value as the number. Use regular integer literals
+     * when the intention is to interpret the integer as a fixed-point value
+     * (this is the fixed-point equivalent of initialising a float from raw
+     * memory values).
+     * @note For formats with fewer fraction bits than PSXFixed, use
+     * Fixed::from_literal() rather than converting a `_fx` literal, which
+     * would round the value twice.
      * @relatedalso PSXFixed
      */
-    constexpr PSXFixed operator"" _fx(long double literal);
+    template <char... Literal>
+    consteval PSXFixed operator"" _fx();
 
     /**
-     * @brief User-defined literal for PSXFixed objects without fractional parts
+     * @brief User-defined literal for PSXFixed16 objects
+     * @details The same as the `_fx` literal, but rounded straight to the
+     * nearest PSXFixed16 value. Literals too large for PSXFixed16 fail to
+     * compile.
      *
      * @b Usage:
      * @code
-     * PSXFixed integral = 123_fx;
+     * PSXFixed16 normal[3] = {0.577_fx16, -0.577_fx16, 0.577_fx16};
      * @endcode
-     * @warning Use this to initialise PSXFixed objects when the intention is
-     * to hold the same value as the integer. Use regular integer literals
-     * when the intention is to interpret the integer as a fixed-point value
-     * (this is the fixed-point equivalent of initialising a float from raw
-     * memory values).
-     * @relatedalso PSXFixed
+     * @note Other formats can define their own literal in the same way, with
+     * Fixed::from_literal().
+     * @relatedalso PSXFixed16
      */
-    constexpr PSXFixed operator"" _fx(unsigned long long int literal);
+    template <char... Literal>
+    consteval PSXFixed16 operator"" _fx16();
 
     /**
-     * @brief PSXFixed-point arithmetic value type for Sony PlayStation
-     * @details Wraps the native 32-bit integers used on the platform for fixed
+     * @brief Fixed-point arithmetic value type
+     * @details Wraps the native integers used on the platform for fixed
      * point arithmetic and allows arithmetic operations to be done on these
      * instances directly, handling the additional arithmetic for emulating
      * fixed-point internally.
-     * @note The fixed-point integers implemented by this type match those
-     * handled by the PSX standard library, which are `Q19.12` numbers when
-     * specified in Q Notation (https://en.wikipedia.org/wiki/Q_(number_format))
+     * @note The fixed-point integers implemented by this type are `QI.F`
+     * numbers when specified in Q Notation (https://en.wikipedia.org/wiki/Q_(number_format))
+     * where `I` is `IntBits` and `F` is `FracBits`. The format handled by the
+     * PSX standard library is available as PSXFixed.
+     * @tparam IntBits number of bits used for the integer part, at least `1`
+     * @tparam FracBits number of bits used for the fraction part, in the range `[1..30]`
+     * @tparam Storage integer type the value is stored as, which must be a
+     * signed or unsigned integer of 8, 16 or 32 bits with exactly
+     * `IntBits + FracBits` bits, plus one for the sign if signed
      */
-    class PSXFixed {
+    template <size_t IntBits, size_t FracBits, typename Storage>
+    class Fixed {
+    private:
+        using Traits = detail::IntegerTraits<Storage>;
+        static_assert(IntBits >= 1, "Fixed must have at least one integer bit");
+        static_assert(FracBits >= 1 and FracBits <= 30, "Fixed must have between 1 and 30 fraction bits");
+        static_assert(
+            IntBits + FracBits + (Traits::IS_SIGNED ? 1 : 0) == Traits::BITS,
+            "Fixed must use all of the bits of its Storage type"
+        );
+
     public:
         /**
          * @brief Underlying base type the fixed-point integer is stored as
-         * @details Should be `int32` or `int` to match the type used by PSX
+         * @details For PSXFixed, this is `int32` to match the type used by PSX
          * standard library in its fixed-point maths routines.
          */
-        using UnderlyingType = int32_t;
+        using UnderlyingType = Storage;
         /** @brief How many bits are used for the integer part of the fixed-point integer */
-        static constexpr size_t DECIMAL_BITS = 19;
+        static constexpr size_t DECIMAL_BITS = IntBits;
         /** @brief How many bits are used for the fraction part of the fixed-point integer */
-        static constexpr size_t FRACTION_BITS = 12;
+        static constexpr size_t FRACTION_BITS = FracBits;
         /**
          * @brief The scale used for the fixed-point integer
-         * @note This matches the scale used by the PSX standard library for
-         * fixed-point arithmetic, which uses a scale of 4096 (macro: `ONE`).
+         * @note For PSXFixed, this matches the scale used by the PSX standard
+         * library for fixed-point arithmetic, which uses a scale of 4096 (macro: `ONE`).
          */
-        static constexpr UnderlyingType SCALE = 1 << PSXFixed::FRACTION_BITS;
+        static constexpr UnderlyingType SCALE = (UnderlyingType)((uint32_t)1 << Fixed::FRACTION_BITS);
         /**
          * @brief How far apart two adjacent fixed-point values are
          */
-        static constexpr double PRECISION = 1.0 / PSXFixed::SCALE;
+        static constexpr double PRECISION = 1.0 / Fixed::SCALE;
         /**
          * @brief The largest difference between a fixed-point value and the
          * "true" value it represents.
          */
-        static constexpr double ACCURACY = PSXFixed::PRECISION / 2.0;
+        static constexpr double ACCURACY = Fixed::PRECISION / 2.0;
         /**
          * @brief Largest integer value representable by the fixed-point type
          */
-        static constexpr UnderlyingType DECIMAL_MAX = (1 << PSXFixed::DECIMAL_BITS) - 1;
+        static constexpr UnderlyingType DECIMAL_MAX = (UnderlyingType)(((uint32_t)1 << Fixed::DECIMAL_BITS) - 1);
         /**
          * @brief Smallest integer value representable by the fixed-point type
          */
-        static constexpr UnderlyingType DECIMAL_MIN = -(1 << PSXFixed::DECIMAL_BITS);
+        static constexpr UnderlyingType DECIMAL_MIN = (UnderlyingType)(Traits::IS_SIGNED ? 0u - ((uint32_t)1 << Fixed::DECIMAL_BITS) : 0u);
         /**
          * @brief Largest real value representable by the fixed-point type
          */
-        static constexpr double FRACTIONAL_MAX = PSXFixed::DECIMAL_MAX + (1.0 - PSXFixed::PRECISION);
+        static constexpr double FRACTIONAL_MAX = Fixed::DECIMAL_MAX + (1.0 - Fixed::PRECISION);
         /**
          * @brief Smallest real value representable by the fixed-point type
          */
-        static constexpr double FRACTIONAL_MIN = PSXFixed::DECIMAL_MIN;
+        static constexpr double FRACTIONAL_MIN = Fixed::DECIMAL_MIN;
         /**
-         * @brief Largest PSXFixed value
+         * @brief Largest Fixed value
          */
-        static constexpr PSXFixed MAX() {
-            return PSXFixed((UnderlyingType)2147483647);
+        static constexpr Fixed MAX() {
+            return Fixed(Traits::MAX);
         }
         /**
-         * @brief Smallest PSXFixed value
+         * @brief Smallest Fixed value
          */
-        static constexpr PSXFixed MIN() {
-            return PSXFixed((UnderlyingType)-2147483648);
+        static constexpr Fixed MIN() {
+            return Fixed(Traits::MIN);
         }
+        class Reciprocal;
+        class Accumulator;
         /**
-         * @brief Default constructor, creates a PSXFixed instance with value `0.0_fx`
+         * @brief Default constructor, creates a Fixed instance with value `0.0_fx`
          */
-        constexpr PSXFixed() : _raw_value(0) {}
+        constexpr Fixed() : _raw_value(0) {}
         /**
          * @brief Implicit converting constructor from fixed-point integer
-         * @details Creates a PSXFixed instance wrapping a raw fixed-point integer,
+         * @details Creates a Fixed instance wrapping a raw fixed-point integer,
          * of the kind used by the PlayStation SDK functions.
-         * @warning Don't use this for converting plain integers into PSXFixed.
-         * Use PSXFixed::from_integer for that.
-         * @see PSXFixed::from_integer
+         * @warning Don't use this for converting plain integers into Fixed.
+         * Use Fixed::from_integer for that.
+         * @see Fixed::from_integer
          */
-        constexpr PSXFixed(UnderlyingType raw_value) : _raw_value(raw_value) {}
+        constexpr Fixed(UnderlyingType raw_value) : _raw_value(raw_value) {}
         /**
          * @brief Implicit converting constructor from float/double
-         * @details Creates a PSXFixed instance with the nearest fixed-point value
+         * @details Creates a Fixed instance with the nearest fixed-point value
          * to the given floating point value.
          * @warning This loses precision.
          * @note Not recommended to use this outside of constexpr contexts
@@ -161,28 +1232,177 @@ namespace unmoving {
          * @todo Consider adding a single-precision `float` version of this
          * methodfor faster emulation when doing runtime conversions on the
          * PlayStation and `double` precision is not needed.
+         * @see UNMOVING_CONSTEVAL_FLOAT to forbid using this at runtime
+         * @see Fixed::from_ratio() for an exact alternative without floating point
          */
-        constexpr PSXFixed(double value) {
-            double scaled = value * PSXFixed::SCALE;
+        UNMOVING_FLOAT_CONSTEXPR Fixed(double value) {
+            double scaled = value * Fixed::SCALE;
             // separate into integer and fraction so we can round the fraction
             UnderlyingType integral = (UnderlyingType)scaled;
             double remainder = scaled - integral;
             // there's no rounding function in the PS1 stdlib so round manually
             if (remainder <= -0.5 or remainder >= 0.5) { // round half to infinity
-                integral += (integral < 0 ? -1 : 1);
+                integral = (UnderlyingType)(detail::is_negative(integral) ? integral - 1 : integral + 1);
             }
             this->_raw_value = integral;
         }
         /**
-         * @returns a PSXFixed instance representing the closest fixed-point value
+         * @brief Converting constructor from other fixed-point formats
+         * @details Creates a Fixed instance with the value of `other`, with
+         * any fraction bits which this format doesn't have truncated towards
+         * zero, and wrapped if out of range.
+         * @note This is implicit only when the conversion is lossless, that
+         * is when this format has at least as many integer and fraction bits
+         * as the format being converted from, and is signed if it is.
+         */
+        template <size_t OtherIntBits, size_t OtherFracBits, typename OtherStorage>
+        explicit(
+            OtherIntBits > IntBits
+            or OtherFracBits > FracBits
+            or (detail::IntegerTraits<OtherStorage>::IS_SIGNED and not Traits::IS_SIGNED)
+        )
+        constexpr Fixed(const Fixed<OtherIntBits, OtherFracBits, OtherStorage>& other) {
+            OtherStorage raw = other;
+            if constexpr (FracBits >= OtherFracBits) {
+                // widening is a sign-extension and a shift only
+                this->_raw_value = (UnderlyingType)((uint32_t)raw << (FracBits - OtherFracBits));
+            } else {
+                // shift the magnitude so that negative values are truncated towards zero too
+                uint32_t magnitude = detail::magnitude(raw) >> (OtherFracBits - FracBits);
+                this->_raw_value = (UnderlyingType)(detail::is_negative(raw) ? 0u - magnitude : magnitude);
+            }
+        }
+        /**
+         * @brief Saturating conversion from other fixed-point formats
+         * @returns A Fixed instance with the value of `other`, with any
+         * fraction bits which this format doesn't have truncated towards
+         * zero, or Fixed::MAX() or Fixed::MIN() if it is out of range.
+         * @b Usage:
+         * @code
+         * PSXFixed16 narrowed = PSXFixed16::saturate(123.45_fx); // -> PSXFixed16::MAX()
+         * @endcode
+         */
+        template <size_t OtherIntBits, size_t OtherFracBits, typename OtherStorage>
+        static constexpr Fixed saturate(const Fixed<OtherIntBits, OtherFracBits, OtherStorage>& other) {
+            OtherStorage raw = other;
+            bool negative = detail::is_negative(raw);
+            uint32_t magnitude = detail::magnitude(raw);
+            // largest magnitude representable with the same sign as other
+            uint32_t limit = negative ? detail::magnitude(Traits::MIN) : detail::magnitude(Traits::MAX);
+            if constexpr (FracBits >= OtherFracBits) {
+                // compare before shifting, so that the shift can't overflow
+                if (magnitude > (limit >> (FracBits - OtherFracBits))) {
+                    return negative ? Fixed::MIN() : Fixed::MAX();
+                }
+                magnitude <<= FracBits - OtherFracBits;
+            } else {
+                magnitude >>= OtherFracBits - FracBits;
+                if (magnitude > limit) {
+                    return negative ? Fixed::MIN() : Fixed::MAX();
+                }
+            }
+            return Fixed((UnderlyingType)(negative ? 0u - magnitude : magnitude));
+        }
+        /**
+         * @returns a Fixed instance representing the closest fixed-point value
          * to the given integer value.
-         * @warning Don't use this for converting raw fixed-point integers to PSXFixed.
-         * Use PSXFixed::PSXFixed(UnderlyingType) for that.
-         * @see PSXFixed::PSXFixed(UnderlyingType)
+         * @warning Don't use this for converting raw fixed-point integers to Fixed.
+         * Use Fixed::Fixed(UnderlyingType) for that.
+         * @see Fixed::Fixed(UnderlyingType)
          * @todo Check for overflow? No exceptions on the PS1...
          */
-        static constexpr PSXFixed from_integer(int value) {
-            return PSXFixed(value << PSXFixed::FRACTION_BITS);
+        static constexpr Fixed from_integer(int value) {
+            return Fixed((UnderlyingType)(value << Fixed::FRACTION_BITS));
+        }
+        /**
+         * @returns The nearest Fixed value to `numerator / denominator`, with
+         * ties rounded away from zero.
+         * @details Calculated exactly using only integer arithmetic, so
+         * unlike Fixed::Fixed(double), this needs no floating point when it
+         * isn't evaluated at compile-time.
+         * @note Results out of range saturate to Fixed::MIN() or Fixed::MAX(),
+         * as does a denominator of zero.
+         * @b Usage:
+         * @code
+         * PSXFixed third = PSXFixed::from_ratio(1, 3);
+         * PSXFixed aspect = PSXFixed::from_ratio(width, height);
+         * @endcode
+         */
+        static constexpr Fixed from_ratio(int numerator, int denominator) {
+            bool negative = (numerator < 0) != (denominator < 0);
+            uint32_t limit = negative ? detail::magnitude(Traits::MIN) : detail::magnitude(Traits::MAX);
+            uint32_t result = 0;
+            if (
+                denominator == 0
+                or not detail::multiply_divide_u32(
+                    detail::magnitude(numerator),
+                    (uint32_t)Fixed::SCALE,
+                    detail::magnitude(denominator),
+                    limit,
+                    result
+                )
+            ) {
+                return negative ? Fixed::MIN() : Fixed::MAX();
+            }
+            return Fixed((UnderlyingType)(negative ? 0u - result : result));
+        }
+        /**
+         * @returns The nearest Fixed value to the numeric literal whose
+         * characters are `Literal`, with ties rounded away from zero
+         * @details Parsed exactly at compile-time, the same as the `_fx`
+         * literal, but rounded straight to the fraction bits of this format.
+         * Converting a `_fx` literal to a format with fewer fraction bits
+         * would round it twice, which doesn't always give the nearest value.
+         * Literals too large for this format fail to compile.
+         *
+         * This is mostly useful for defining a literal for a format:
+         * @code
+         * using UV = Fixed<8, 8, uint16_t>;
+         * template <char... Literal>
+         * consteval UV operator"" _uv() { return UV::from_literal<Literal...>(); }
+         *
+         * UV u = 0.1_uv; // the same as UV::from_literal<'0', '.', '1'>()
+         * @endcode
+         * @see operator""_fx()
+         * @see operator""_fx16()
+         */
+        template <char... Literal>
+        static consteval Fixed from_literal() {
+            constexpr detail::ParsedLiteral PARSED = detail::parse_literal<Literal...>(
+                FracBits,
+                (uint32_t)Traits::MAX
+            );
+            static_assert(PARSED.in_range, "Literal is too large for this Fixed format");
+            return Fixed((UnderlyingType)PARSED.raw);
+        }
+        /**
+         * @returns The nearest Fixed value to the IEEE-754 single-precision
+         * float whose bits are `bits`, rounded exactly the same way as by
+         * Fixed::Fixed(double).
+         * @details The float is decoded with integer shifts only, so this is
+         * much faster than converting it to Fixed on the PlayStation, which
+         * has no hardware floating point. Use it to convert data which was
+         * authored as floats when loading it.
+         * @note Values out of range saturate to Fixed::MIN() or Fixed::MAX()
+         * (infinities included), and NaNs become zero.
+         * @b Usage:
+         * @code
+         * uint32_t bits = 0x3FC00000; // 1.5f
+         * PSXFixed value = PSXFixed::from_float_bits(bits); // -> 1.5_fx
+         * @endcode
+         */
+        static constexpr Fixed from_float_bits(uint32_t bits) {
+            return Fixed::from_parts(detail::float_parts(bits));
+        }
+        /**
+         * @returns The nearest Fixed value to the IEEE-754 double-precision
+         * float whose bits are `bits`, rounded exactly the same way as by
+         * Fixed::Fixed(double).
+         * @details The same as Fixed::from_float_bits() but for doubles.
+         * Only 32-bit integer arithmetic is used.
+         */
+        static constexpr Fixed from_double_bits(uint64_t bits) {
+            return Fixed::from_parts(detail::double_parts(bits));
         }
         /**
          * @brief Implicit cast operator to underlying type
@@ -192,15 +1412,15 @@ namespace unmoving {
         }
         /**
          * @brief Explicit cast operator to double
-         * @details Returns exact value of this PSXFixed instance as double-precision floating point
+         * @details Returns exact value of this Fixed instance as double-precision floating point
          * @note There is enough precision in double-precision IEEE floats to
-         * exactly represent all PSXFixed point values.
+         * exactly represent all Fixed point values.
          * @note Not recommended to use this outside of constexpr contexts
          * where avoidable on the PlayStation, as the console has no hardware
          * floating point support, so slow software floats will be used.
          */
-        explicit constexpr operator double() const {
-            return (double)this->_raw_value / PSXFixed::SCALE;
+        explicit UNMOVING_FLOAT_CONSTEXPR operator double() const {
+            return (double)this->_raw_value / Fixed::SCALE;
         }
         /**
          * @brief Explicit cast operator to float
@@ -213,204 +1433,700 @@ namespace unmoving {
          * where avoidable on the PlayStation, as the console has no hardware
          * floating point support, so slow software floats will be used.
          */
-        explicit constexpr operator float() const {
+        explicit UNMOVING_FLOAT_CONSTEXPR operator float() const {
             // reuse cast to double and then narrow it to float
             return (float)(double)*this;
         }
         /**
-         * @returns PSXFixed-point value converted to integer, with fractional part truncated.
+         * @returns Fixed-point value converted to integer, with fractional part truncated.
          */
         constexpr UnderlyingType to_integer() const {
             // can't use a right-shift here due to it not handling negative values properly
-            return this->_raw_value / PSXFixed::SCALE;
+            return (UnderlyingType)(this->_raw_value / Fixed::SCALE);
+        }
+        /**
+         * @returns The reciprocal of this value, which other values can be
+         * multiplied by to divide them by this value.
+         * @details This is useful when dividing many values by the same
+         * divisor, as the reciprocal only needs to be calculated once, after
+         * which each division costs only a multiplication and a shift.
+         * The reciprocal is calculated with a table-seeded Newton-Raphson
+         * iteration, using no 64-bit arithmetic.
+         * @warning The reciprocal of zero is undefined. Multiplying by it gives zero.
+         * @see Fixed::Reciprocal
+         */
+        constexpr Reciprocal reciprocal() const {
+            return Reciprocal(this->_raw_value);
+        }
+        /**
+         * @brief Approximate division, faster than the division operator
+         * @returns This value divided by `divisor`, which may be one step
+         * further from zero than the result of the division operator.
+         * @note If dividing several values by the same divisor, it is faster to
+         * call Fixed::reciprocal() on it and multiply by the result.
+         * @see Fixed::Reciprocal
+         */
+        constexpr Fixed fast_div(const Fixed& divisor) const {
+            return *this * divisor.reciprocal();
         }
         /**
-         * @brief Stringifies the PSXFixed-point value to a C-string
-         * @details Output is equivalent to `printf()`-family `%.6f`, so trailing zeroes are always displayed
+         * @brief Fused multiplication and division
+         * @returns `a * b / c`, rounded to the nearest Fixed value (with ties
+         * rounded away from zero).
+         * @details The full product of `a` and `b` is divided by `c` directly,
+         * so unlike `a * b / c`, the result is only rounded once, and can't
+         * overflow in the middle if only the product is out of range. This
+         * is useful for interpolation and scaling by ratios.
+         * @param[out] overflow if not null, set to whether the result was out
+         * of range, in which case the result is saturated to Fixed::MIN() or
+         * Fixed::MAX(). Division by zero counts as overflow.
+         * @b Usage:
+         * @code
+         * // 1000 * 1000 is out of range of PSXFixed, but the result isn't
+         * PSXFixed ratio = PSXFixed::mul_div(1000_fx, 1000_fx, 2000_fx); // 500.0_fx
+         * @endcode
+         */
+        static constexpr Fixed mul_div(const Fixed& a, const Fixed& b, const Fixed& c, bool* overflow = nullptr) {
+            bool overflowed = false;
+            Fixed result(detail::multiply_divide(a._raw_value, b._raw_value, c._raw_value, overflowed));
+            if (overflow != nullptr) { *overflow = overflowed; }
+            return result;
+        }
+        /**
+         * @brief Fused multiplication and shift
+         * @returns `a * b / 2**shift`, rounded to the nearest Fixed value (with
+         * ties rounded away from zero).
+         * @details As with Fixed::mul_div(), the full product is kept until
+         * the end, so the result is only rounded once and only overflows if
+         * the result itself is out of range.
+         * @param shift must be in the range `[0..31]`
+         * @param[out] overflow if not null, set to whether the result was out
+         * of range, in which case the result is saturated to Fixed::MIN() or
+         * Fixed::MAX().
+         */
+        static constexpr Fixed mul_shift(const Fixed& a, const Fixed& b, size_t shift, bool* overflow = nullptr) {
+            bool overflowed = false;
+            Fixed result(detail::multiply_shift_rounded(a._raw_value, b._raw_value, Fixed::FRACTION_BITS + shift, overflowed));
+            if (overflow != nullptr) { *overflow = overflowed; }
+            return result;
+        }
+        /**
+         * @brief A compile-time constant operand for Fixed::div_by() and Fixed::mul_by()
+         * @details Can be implicitly constructed from either an integer or a
+         * Fixed, which are then treated the same way as the integer and
+         * Fixed overloads of the arithmetic operators treat them.
+         */
+        struct Constant {
+            /**
+             * @brief Creates an integer constant
+             */
+            constexpr Constant(UnderlyingType integer) : value(integer), is_fixed(false) {}
+            /**
+             * @brief Creates a fixed-point constant
+             */
+            constexpr Constant(Fixed fixed) : value(fixed), is_fixed(true) {}
+            /** @brief The integer, or raw fixed-point value of the constant */
+            UnderlyingType value;
+            /** @brief Whether Fixed::Constant::value is a raw fixed-point value */
+            bool is_fixed;
+        };
+        /**
+         * @brief Division by a compile-time constant
+         * @details Gives exactly the same result as the division operator,
+         * but the division is done with a multiplication and a shift, using a
+         * "magic number" calculated at compile-time.
+         * @b Usage:
+         * @code
+         * PSXFixed third = x.div_by<3>();       // same as x / 3
+         * PSXFixed scaled = x.div_by<1.5_fx>(); // same as x / 1.5_fx
+         * @endcode
+         * @note Division by a power of two is done with a shift only.
+         * Division by a Fixed constant which is larger than `128.0_fx` may
+         * need two multiplications, or fall back to the division operator.
+         * @tparam DIVISOR an integer or Fixed constant, which must not be zero
+         */
+        template <Constant DIVISOR>
+        constexpr Fixed div_by() const {
+            static_assert(DIVISOR.value != 0, "Division by zero");
+            constexpr detail::ConstantDivisor divisor = detail::constant_divisor(
+                detail::magnitude(DIVISOR.value),
+                detail::is_negative(DIVISOR.value),
+                DIVISOR.is_fixed ? Fixed::FRACTION_BITS : 0,
+                // the magnitude of any signed value fits in 31 bits, as does that of any smaller unsigned one
+                Traits::BITS == 32 and not Traits::IS_SIGNED ? 32 : 31
+            );
+            if constexpr (divisor.use_magic) {
+                uint32_t quotient = detail::divide_constant(detail::magnitude(this->_raw_value), divisor);
+                return Fixed((UnderlyingType)(detail::is_negative(this->_raw_value) != divisor.negative ? 0u - quotient : quotient));
+            } else if constexpr (DIVISOR.is_fixed) {
+                return *this / Fixed(DIVISOR.value);
+            } else {
+                return *this / DIVISOR.value;
+            }
+        }
+        /**
+         * @brief Multiplication by a compile-time constant
+         * @details Gives exactly the same result as the multiplication
+         * operator, but with the constant decomposed into an odd multiplier
+         * and a shift at compile-time. Multiplying by powers of two is done
+         * with a shift only, and multiplying by integers or Fixed constants
+         * with integral values is done with a 32-bit multiplication, which the
+         * compiler can turn into shifts and adds.
+         * @b Usage:
+         * @code
+         * PSXFixed doubled = x.mul_by<2>();     // same as x * 2
+         * PSXFixed half = x.mul_by<0.5_fx>();   // same as x * 0.5_fx
+         * @endcode
+         * @tparam MULTIPLIER an integer or Fixed constant
+         */
+        template <Constant MULTIPLIER>
+        constexpr Fixed mul_by() const {
+            constexpr detail::ConstantMultiplier multiplier = detail::constant_multiplier(
+                detail::magnitude(MULTIPLIER.value),
+                detail::is_negative(MULTIPLIER.value),
+                MULTIPLIER.is_fixed ? Fixed::FRACTION_BITS : 0
+            );
+            uint32_t product = detail::multiply_constant(detail::magnitude(this->_raw_value), multiplier);
+            return Fixed((UnderlyingType)(detail::is_negative(this->_raw_value) != multiplier.negative ? 0u - product : product));
+        }
+        /**
+         * @brief Writes the decimal representation of the value to a range of characters
+         * @details Output is equivalent to `printf()`-family `%.6f` (but with
+         * the fraction truncated rather than rounded), so trailing zeroes are
+         * always written. No null-terminator is written. The digits are
+         * worked out two at a time with integer arithmetic only, so this is
+         * much faster than `printf()` and can be used at compile-time.
+         * @param first,last the range `[first, last)` to write to
+         * @returns the end of the characters written (so `ptr - first` is the
+         * number written), or `last` and no characters written with
+         * `success` set to `false` if the range was too small.
+         * @b Usage:
+         * @code
+         * char buffer[16];
+         * ToCharsResult result = x.to_chars(buffer, buffer + sizeof(buffer));
+         * @endcode
+         */
+        constexpr ToCharsResult to_chars(char* first, char* last) const {
+            uint32_t magnitude = detail::magnitude(this->_raw_value);
+            uint32_t whole = magnitude >> Fixed::FRACTION_BITS;
+            // this gives us 6 decimal places, computed with a wider intermediate as it can overflow 32 bits
+            uint32_t fraction = detail::multiply_shift_u32(magnitude & ((uint32_t)Fixed::SCALE - 1), 1'000'000, Fixed::FRACTION_BITS);
+            bool negative = detail::is_negative(this->_raw_value);
+            size_t whole_digits = detail::count_digits(whole);
+            // the sign, the whole part, the point and 6 decimal places
+            size_t length = (negative ? 1 : 0) + whole_digits + 1 + 6;
+            if ((size_t)(last - first) < length) { return {last, false}; }
+            char* cursor = first;
+            if (negative) { *cursor++ = '-'; }
+            cursor += whole_digits;
+            detail::write_digits(cursor, whole, whole_digits);
+            *cursor++ = '.';
+            cursor += 6;
+            detail::write_digits(cursor, fraction, 6);
+            return {cursor, true};
+        }
+        /**
+         * @brief Writes the decimal representation of the value to a range of
+         * characters, with `precision` digits after the point
+         * @details The value is correctly rounded to `precision` digits, with
+         * ties rounded to even, so the output is the same as that of
+         * `printf()`-family `%.*f`. There is no point if `precision` is zero.
+         * Only integer arithmetic is used.
+         * @returns The same as Fixed::to_chars(char*, char*) const
+         * @b Usage:
+         * @code
+         * x.to_chars(buffer, buffer + sizeof(buffer), 2); // 1.005_fx -> "1.00"
+         * @endcode
+         */
+        constexpr ToCharsResult to_chars(char* first, char* last, size_t precision) const {
+            uint32_t magnitude = detail::magnitude(this->_raw_value);
+            uint32_t whole = magnitude >> Fixed::FRACTION_BITS;
+            uint32_t fraction = magnitude & ((uint32_t)Fixed::SCALE - 1);
+            size_t bits = Fixed::FRACTION_BITS;
+            // every digit after the first FRACTION_BITS is zero
+            char digits[Fixed::FRACTION_BITS] = {};
+            size_t count = precision < Fixed::FRACTION_BITS ? precision : Fixed::FRACTION_BITS;
+            for (size_t i = 0; i < count; i++) {
+                digits[i] = (char)('0' + detail::next_decimal_digit(fraction, bits));
+            }
+            // round what's left, which is fraction / 2**bits
+            if (bits != 0) {
+                uint32_t half = (uint32_t)1 << (bits - 1);
+                bool odd = count != 0 ? (digits[count - 1] & 1) != 0 : (whole & 1) != 0;
+                if (fraction > half or (fraction == half and odd)) {
+                    size_t i = count;
+                    for (; i > 0 and digits[i - 1] == '9'; i--) {
+                        digits[i - 1] = '0';
+                    }
+                    if (i > 0) {
+                        digits[i - 1]++;
+                    } else {
+                        whole++;
+                    }
+                }
+            }
+            bool negative = detail::is_negative(this->_raw_value);
+            char* end = detail::write_decimal(first, last, negative, whole, digits, count, precision - count);
+            if (end == nullptr) { return {last, false}; }
+            return {end, true};
+        }
+        /**
+         * @brief Writes the shortest decimal representation of the value
+         * which converts back to exactly the same value to a range of
+         * characters
+         * @details Converting the output back to Fixed with rounding to
+         * nearest (such as with the `_fx` literal) always gives this value.
+         * If there's more than one shortest representation, the nearest one
+         * to the value is written. There is no point if no fraction digits
+         * are needed. Only integer arithmetic is used.
+         * @returns The same as Fixed::to_chars(char*, char*) const
+         * @b Usage:
+         * @code
+         * 0.1_fx.to_shortest_chars(buffer, buffer + sizeof(buffer)); // -> "0.1"
+         * @endcode
+         */
+        constexpr ToCharsResult to_shortest_chars(char* first, char* last) const {
+            uint32_t magnitude = detail::magnitude(this->_raw_value);
+            uint32_t whole = magnitude >> Fixed::FRACTION_BITS;
+            // the rest of the value and the margin either side of it in units of 2**-bits, where the margin is half a step
+            size_t bits = Fixed::FRACTION_BITS + 1;
+            uint32_t rest = (magnitude & ((uint32_t)Fixed::SCALE - 1)) << 1;
+            uint32_t margin = 1;
+            char digits[Fixed::FRACTION_BITS] = {};
+            size_t count = 0;
+            /*
+             * stop as soon as the digits so far, or those with the last one
+             * rounded up, are within the margin (halfway rounds away from zero,
+             * so the margin includes its end nearest to zero)
+             */
+            while (rest > margin and ((uint32_t)1 << bits) - rest >= margin) {
+                digits[count++] = (char)('0' + detail::next_decimal_digit(rest, bits));
+                margin *= 5;
+            }
+            uint32_t remaining = ((uint32_t)1 << bits) - rest;
+            if (remaining < margin and (rest > margin or remaining <= rest)) {
+                /*
+                 * NOTE: the last digit can't be a 9, as then the value would
+                 * have been within the margin of the digits before it rounded up
+                 */
+                if (count != 0) {
+                    digits[count - 1]++;
+                } else {
+                    whole++;
+                }
+            }
+            bool negative = detail::is_negative(this->_raw_value);
+            char* end = detail::write_decimal(first, last, negative, whole, digits, count, 0);
+            if (end == nullptr) { return {last, false}; }
+            return {end, true};
+        }
+        /**
+         * @brief Parses a decimal number from a range of characters
+         * @details Reads an optional sign, whole digits and fraction digits
+         * after a point (like `std::from_chars()` with
+         * `std::chars_format::fixed`, but allowing a `+` sign too), and
+         * rounds the number to the nearest Fixed value, with ties rounded
+         * away from zero, the same as the `_fx` literal. The rounding is
+         * exact whatever the number of digits, and only integer arithmetic
+         * is used. Parsing stops at the first character which can't be part
+         * of the number, and whitespace isn't skipped.
+         * @param first,last the range `[first, last)` to parse
+         * @param[out] value set to the number parsed, only if there was no error
+         * @returns The end of the number, and any error. If there is no
+         * number, `ptr` is `first`.
+         * @b Usage:
+         * @code
+         * PSXFixed speed;
+         * FromCharsResult result = PSXFixed::from_chars(text, text + length, speed);
+         * if (result.error != FromCharsError::NONE) { ... }
+         * @endcode
+         */
+        static constexpr FromCharsResult from_chars(const char* first, const char* last, Fixed& value) {
+            const char* cursor = first;
+            bool negative = false;
+            if (cursor != last and (*cursor == '-' or *cursor == '+')) {
+                negative = *cursor == '-';
+                cursor++;
+            }
+            uint32_t limit = negative ? detail::magnitude(Traits::MIN) : detail::magnitude(Traits::MAX);
+            uint32_t whole_limit = limit >> Fixed::FRACTION_BITS;
+            uint32_t whole = 0;
+            bool out_of_range = false;
+            bool any_digits = false;
+            for (; cursor != last and detail::is_digit(*cursor); cursor++) {
+                uint32_t digit = (uint32_t)(*cursor - '0');
+                // keep reading the digits even if out of range, to find the end of the number
+                if (digit > whole_limit or whole > (whole_limit - digit) / 10) {
+                    out_of_range = true;
+                } else {
+                    whole = whole * 10 + digit;
+                }
+                any_digits = true;
+            }
+            /*
+             * only the first FRACTION_BITS + 1 digits can affect the result,
+             * as halfway between two Fixed values has that many digits and
+             * the rest can only be less than a unit in the last of them
+             */
+            uint8_t digits[Fixed::FRACTION_BITS + 1] = {};
+            size_t count = 0;
+            if (cursor != last and *cursor == '.') {
+                const char* point = cursor++;
+                for (; cursor != last and detail::is_digit(*cursor); cursor++) {
+                    if (count < Fixed::FRACTION_BITS + 1) {
+                        digits[count++] = (uint8_t)(*cursor - '0');
+                    }
+                    any_digits = true;
+                }
+                // a point without digits either side of it isn't part of the number
+                if (not any_digits) { cursor = point; }
+            }
+            if (not any_digits) { return {first, FromCharsError::INVALID}; }
+            if (out_of_range) { return {cursor, FromCharsError::OUT_OF_RANGE}; }
+            uint32_t fraction = 0;
+            bool round_up = false;
+            if (count != 0) {
+                fraction = detail::scale_decimal_fraction(digits, count, Fixed::FRACTION_BITS, round_up);
+            }
+            // can't overflow, as whole <= whole_limit
+            uint32_t magnitude = (whole << Fixed::FRACTION_BITS) + fraction;
+            if (magnitude > limit or (round_up and magnitude == limit)) {
+                return {cursor, FromCharsError::OUT_OF_RANGE};
+            }
+            magnitude += round_up ? 1u : 0u;
+            value = Fixed((UnderlyingType)(negative ? 0u - magnitude : magnitude));
+            return {cursor, FromCharsError::NONE};
+        }
+        /**
+         * @brief Stringifies the Fixed-point value to a C-string
+         * @details Output is the same as that of Fixed::to_chars(), followed
+         * by a null-terminator.
          * @param buffer pointer to array of `char`. Must be non-null and pointing to buffer of size `buffer_size`.
-         * @param[out] buffer_size size of `buffer`. Should be at least `15`.
+         * @param[out] buffer_size size of `buffer`. Should be at least `15` for PSXFixed.
          * @returns `false` if buffer could not be written, because buffer_size wasn't big enough
          * @returns `true` if buffer was written
-         * @note Although conforming C-libraries check if `buffer == nullptr` for you, the implementation of `vsnprintf()`
-         * in libPSn00bSDK, which this project is intended for use with, doesn't seem to check if `buffer == NULL`, hence
-         * the need to check it here.
-         * @todo Consider replacing the call to `snprintf()` with a call to
-         * `sprintf()` --it looks like the original Sony C library doesn't support
-         * `snprintf()`...
-         * @todo Consider adding the ability to reduce the number of displayed decimal places, or to remove trailing zeroes
+         * @note `buffer_size` must be enough for the longest value of the
+         * format, even if this value is shorter.
+         * @see Fixed::to_chars(char*, char*, size_t) const for fewer decimal places
+         * @see Fixed::to_shortest_chars() for no trailing zeroes
          */
         constexpr bool to_c_str(char* buffer, size_t buffer_size) const {
             // don't write to a null-pointer!
             if (buffer == nullptr) { return false; }
-            // need at least 14 characters and 1 for the null-terminator
-            if (buffer_size < 15) { return false; } // refuse if not at least this many in buffer
-            int decimal_part = this->_raw_value / 4096; // floor-divide
-            // decompose the fractional part into an unsigned int to allow us to scale it up for more decimal places
-            unsigned int remainder = ((unsigned int)abs(this->_raw_value)) % 4096;
-            // 1M is the maximum we can scale it up without overflow, since 4096*1M = 4096M, compared to max uint32 = ~4294M
-            unsigned int fractional_part = (remainder * 1'000'000) / 4096; // this gives us 6 decimal places
-            // can't print a negative sign if negative but decimal_part is zero
-            if (this->_raw_value < 0 and decimal_part == 0) {
-                snprintf(buffer, buffer_size, "-0.%06u", fractional_part);
-            } else { // otherwise, we can rely on snprintf() to do it for us
-                snprintf(buffer, buffer_size, "%d.%06u", decimal_part, fractional_part);
-            }
+            // need the sign, the widest decimal part, the point, 6 decimal places and 1 for the null-terminator
+            constexpr size_t minimum_size = (Traits::IS_SIGNED ? 1 : 0)
+                + detail::count_digits(detail::magnitude(Traits::IS_SIGNED ? Fixed::DECIMAL_MIN : Fixed::DECIMAL_MAX))
+                + 1 + 6 + 1;
+            if (buffer_size < minimum_size) { return false; } // refuse if not at least this many in buffer
+            // always fits, leaving room for the null-terminator
+            *this->to_chars(buffer, buffer + buffer_size - 1).ptr = '\0';
             return true;
         }
         /**
          * @brief Prefix increment operator
          */
-        constexpr PSXFixed& operator++() {
-            *this += PSXFixed::SCALE;
+        constexpr Fixed& operator++() {
+            *this += Fixed::SCALE;
             return *this;
         }
         /**
          * @brief Prefix decrement operator
          */
-        constexpr PSXFixed& operator--() {
-            *this -= PSXFixed::SCALE;
+        constexpr Fixed& operator--() {
+            *this -= Fixed::SCALE;
             return *this;
         }
         /**
          * @brief Postfix increment operator
          */
-        constexpr PSXFixed operator++(int) {
-            PSXFixed old = *this; // copy old value
+        constexpr Fixed operator++(int) {
+            Fixed old = *this; // copy old value
             ++*this; // prefix increment
             return old; // return old value
         }
         /**
          * @brief Postfix decrement operator
          */
-        constexpr PSXFixed operator--(int) {
-            PSXFixed old = *this; // copy old value
+        constexpr Fixed operator--(int) {
+            Fixed old = *this; // copy old value
             --*this; // prefix decrement
             return old; // return old value
         }
         /**
          * @brief Compound assignment addition operator
          */
-        constexpr PSXFixed& operator +=(const PSXFixed& rhs) {
-            this->_raw_value += rhs._raw_value;
+        constexpr Fixed& operator +=(const Fixed& rhs) {
+            this->_raw_value = (UnderlyingType)(this->_raw_value + rhs._raw_value);
             return *this;
         }
         /**
          * @brief Compound assignment subtraction operator
          */
-        constexpr PSXFixed& operator -=(const PSXFixed& rhs) {
-            this->_raw_value -= rhs._raw_value;
+        constexpr Fixed& operator -=(const Fixed& rhs) {
+            this->_raw_value = (UnderlyingType)(this->_raw_value - rhs._raw_value);
             return *this;
         }
         /**
          * @brief Compound assignment multiplication operator
-         * @todo Investigate performance impact of compiler-generated 64-bit
-         * multiplication emulation on 32-bit MIPS. If poor performance,
-         * consider utilising Lameguy64's suggested implementation using inline
-         * assembly to take advantage of the R3000's 64-bit double-word multiply
-         * feature.
-         */
-        constexpr PSXFixed& operator *=(const PSXFixed& rhs) {
-            // XXX: no int64_t on PS1, software emulation kicks in automatically
-            int64_t result = (int64_t)this->_raw_value * rhs._raw_value;
-            // shift back down
-            this->_raw_value = (UnderlyingType)(result / PSXFixed::SCALE);
+         * @details The result is rounded towards zero.
+         * @note When UNMOVING_USE_INT64 is `0`, this is done with 32-bit
+         * arithmetic only. On MIPS, this uses the R3000's 64-bit double-word
+         * multiply instruction directly, as suggested by Lameguy64.
+         */
+        constexpr Fixed& operator *=(const Fixed& rhs) {
+            this->_raw_value = detail::multiply_shift(this->_raw_value, rhs._raw_value, Fixed::FRACTION_BITS);
             return *this;
         }
         /**
          * @brief Compound assignment integer multiplication operator
          * @todo Investigate overflow?
          */
-        constexpr PSXFixed& operator *=(const UnderlyingType& rhs) {
-            this->_raw_value *= rhs;
+        constexpr Fixed& operator *=(const UnderlyingType& rhs) {
+            this->_raw_value = (UnderlyingType)(this->_raw_value * rhs);
             return *this;
         }
         /**
          * @brief Compound assignment division operator
-         * @todo Investigate performance impact of compiler-generated 64-bit
-         * multiplication emulation on 32-bit MIPS. If poor performance,
-         * consider utilising Lameguy64's suggested implementation using inline
-         * assembly to take advantage of the R3000's 64-bit double-word multiply
-         * feature.
-         */
-        constexpr PSXFixed& operator /=(const PSXFixed& rhs) {
-            // XXX: no int64_t on PS1, software emulation kicks in automatically
-            int64_t scaled = (int64_t)this->_raw_value * PSXFixed::SCALE;
-            this->_raw_value = (UnderlyingType)(scaled / rhs._raw_value);
+         * @details The result is rounded towards zero.
+         * @note When UNMOVING_USE_INT64 is `0`, this is done with 32-bit
+         * arithmetic only, using one or two native 32-bit divisions in most
+         * cases and falling back to bitwise long division for the fraction bits
+         * of the quotient only when the remainder is too large to be scaled.
+         */
+        constexpr Fixed& operator /=(const Fixed& rhs) {
+            this->_raw_value = detail::divide_shift(this->_raw_value, rhs._raw_value, Fixed::FRACTION_BITS);
             return *this;
         }
         /**
          * @brief Compound assignment integer division operator
          * @todo Investigate overflow?
          */
-        constexpr PSXFixed& operator /=(const UnderlyingType& rhs) {
-            this->_raw_value /= rhs;
+        constexpr Fixed& operator /=(const UnderlyingType& rhs) {
+            this->_raw_value = (UnderlyingType)(this->_raw_value / rhs);
             return *this;
         }
         /**
          * @brief Unary minus (negation) operator
          */
-        constexpr PSXFixed operator-() const {
-            return PSXFixed(-this->_raw_value);
+        constexpr Fixed operator-() const {
+            return Fixed((UnderlyingType)(0u - (uint32_t)this->_raw_value));
         }
         /**
          * @brief Addition operator
          */
-        constexpr friend PSXFixed operator+(PSXFixed lhs, const PSXFixed& rhs) {
+        constexpr friend Fixed operator+(Fixed lhs, const Fixed& rhs) {
             lhs += rhs;
             return lhs;
         }
         /**
          * @brief Subtraction operator
          */
-        constexpr friend PSXFixed operator-(PSXFixed lhs, const PSXFixed& rhs) {
+        constexpr friend Fixed operator-(Fixed lhs, const Fixed& rhs) {
             lhs -= rhs;
             return lhs;
         }
         /**
          * @brief Multiplication operator
          */
-        constexpr friend PSXFixed operator*(PSXFixed lhs, const PSXFixed& rhs) {
+        constexpr friend Fixed operator*(Fixed lhs, const Fixed& rhs) {
             lhs *= rhs;
             return lhs;
         }
         /**
          * @brief Integer multiplication operator
          */
-        constexpr friend PSXFixed operator*(PSXFixed lhs, const UnderlyingType& rhs) {
+        constexpr friend Fixed operator*(Fixed lhs, const UnderlyingType& rhs) {
             lhs *= rhs;
             return lhs;
         }
         /**
          * @brief Integer multiplication operator
          */
-        constexpr friend PSXFixed operator*(UnderlyingType lhs, const PSXFixed& rhs) {
+        constexpr friend Fixed operator*(UnderlyingType lhs, const Fixed& rhs) {
             return rhs * lhs;
         }
         /**
          * @brief Division operator
          */
-        constexpr friend PSXFixed operator/(PSXFixed lhs, const PSXFixed& rhs) {
+        constexpr friend Fixed operator/(Fixed lhs, const Fixed& rhs) {
             lhs /= rhs;
             return lhs;
         }
         /**
          * @brief Integer division operator
          */
-        constexpr friend PSXFixed operator/(PSXFixed lhs, const UnderlyingType& rhs) {
+        constexpr friend Fixed operator/(Fixed lhs, const UnderlyingType& rhs) {
             lhs /= rhs;
             return lhs;
         }
 
+        /**
+         * @brief The reciprocal of a Fixed value, as returned by Fixed::reciprocal()
+         * @details Multiplying a Fixed by this is equivalent to dividing it
+         * by the value this is the reciprocal of. It is stored with more
+         * precision than a Fixed could hold, so as long as the exact
+         * quotient is within range, the result is either exactly the same as
+         * the result of the division operator, or one step (1 ULP) further
+         * from zero than it.
+         * @note Division by powers of two is always exact.
+         */
+        class Reciprocal {
+        public:
+            /**
+             * @brief Explicit cast operator to Fixed
+             * @returns The reciprocal as a Fixed, which has the same
+             * accuracy as dividing by the value this is the reciprocal of, but
+             * which loses precision when used for further multiplication.
+             */
+            explicit constexpr operator Fixed() const {
+                return Fixed(Fixed::SCALE) * *this;
+            }
+            /**
+             * @brief Multiplication operator, divides `lhs` by the value this is the reciprocal of
+             */
+            constexpr friend Fixed operator*(const Fixed& lhs, const Reciprocal& rhs) {
+                UnderlyingType raw = lhs;
+                uint32_t quotient = detail::multiply_shift_u32(detail::magnitude(raw), rhs._mantissa, rhs._shift);
+                return Fixed((UnderlyingType)(detail::is_negative(raw) != rhs._negative ? 0u - quotient : quotient));
+            }
+            /**
+             * @brief Multiplication operator, divides `rhs` by the value this is the reciprocal of
+             */
+            constexpr friend Fixed operator*(const Reciprocal& lhs, const Fixed& rhs) {
+                return rhs * lhs;
+            }
+
+        private:
+            friend Fixed;
+
+            /*
+             * Stores the reciprocal of `divisor` as a 32-bit mantissa and a shift,
+             * such that raw / divisor * SCALE = raw * _mantissa / 2**_shift
+             */
+            constexpr Reciprocal(UnderlyingType divisor)
+              : _mantissa(0)
+              , _shift(32)
+              , _negative(detail::is_negative(divisor))
+              {
+                if (divisor == 0) { return; }
+                // normalise the divisor so its top bit is set
+                size_t zeroes = detail::count_leading_zeros(detail::magnitude(divisor));
+                uint32_t normalised = detail::magnitude(divisor) << zeroes;
+                // divisor = normalised / 2**zeroes, and the mantissa is (close to) 2**63 / normalised
+                this->_shift = 63 - Fixed::FRACTION_BITS - zeroes;
+                if (normalised == 0x80000000u) {
+                    // 2**63 / 2**31 doesn't fit in 32 bits, so halve the mantissa and the shift to match
+                    this->_mantissa = 0x80000000u;
+                    this->_shift--;
+                } else {
+                    this->_mantissa = detail::reciprocal_u32(normalised);
+                }
+            }
+
+            uint32_t _mantissa;
+            size_t _shift;
+            bool _negative;
+        };
+
+        /**
+         * @brief Sums products of Fixed values without rounding each of them
+         * @details Works like the MAC registers of the GTE: each product is
+         * added to a 64-bit sum at full precision, and only the final sum is
+         * shifted back to a Fixed, rounding towards zero. This is both faster
+         * and more accurate than summing the results of the multiplication
+         * operator, so is useful for dot products, matrix rows and filters.
+         * @b Usage:
+         * @code
+         * PSXFixed dot = PSXFixed::Accumulator().mac(ax, bx).mac(ay, by).mac(az, bz).result();
+         * @endcode
+         * @note When UNMOVING_USE_INT64 is `0`, the sum is held in a pair of
+         * 32-bit integers. For formats stored in 16 bits or fewer, each
+         * product is done with a 32-bit multiplication.
+         * @warning For signed formats, the result is wrong if the sum
+         * doesn't fit in a signed 64-bit integer, which can only happen when
+         * summing products of values close to Fixed::MIN() or Fixed::MAX(),
+         * or a great many products. The results for unsigned formats are
+         * always correct (wrapped to the size of the format).
+         */
+        class Accumulator {
+        public:
+            /**
+             * @brief Creates an Accumulator with a sum of zero
+             */
+            constexpr Accumulator() : _sum() {}
+            /**
+             * @brief Multiply-accumulate, adds the full product of `lhs` and `rhs` to the sum
+             */
+            constexpr Accumulator& mac(const Fixed& lhs, const Fixed& rhs) {
+                this->_sum = detail::wide_add(this->_sum, detail::wide_product(lhs._raw_value, rhs._raw_value));
+                return *this;
+            }
+            /**
+             * @brief Compound assignment addition operator, adds `value` to the sum
+             */
+            constexpr Accumulator& operator +=(const Fixed& value) {
+                this->_sum = detail::wide_add(this->_sum, detail::wide_product(value._raw_value, Fixed::SCALE));
+                return *this;
+            }
+            /**
+             * @brief Compound assignment subtraction operator, subtracts `value` from the sum
+             */
+            constexpr Accumulator& operator -=(const Fixed& value) {
+                this->_sum = detail::wide_add(
+                    this->_sum,
+                    detail::wide_negate(detail::wide_product(value._raw_value, Fixed::SCALE))
+                );
+                return *this;
+            }
+            /**
+             * @returns The sum, rounded towards zero and wrapped if it is out of range
+             */
+            constexpr Fixed result() const {
+                return Fixed(detail::wide_shift<UnderlyingType>(this->_sum, Fixed::FRACTION_BITS));
+            }
+            /**
+             * @brief Explicit cast operator to Fixed, the same as Fixed::Accumulator::result()
+             */
+            explicit constexpr operator Fixed() const {
+                return this->result();
+            }
+
+        private:
+            detail::Wide _sum;
+        };
+
     private:
+        // the nearest Fixed to a decoded IEEE-754 number, saturated
+        static constexpr Fixed from_parts(detail::FloatParts parts) {
+            uint32_t whole = 0;
+            bool half = false;
+            bool fits = detail::split_scaled(parts.significand, parts.exponent + (int32_t)FracBits, whole, half);
+            /*
+             * like Fixed::Fixed(double), which steps away from zero by the sign
+             * of the whole part, values with no whole part always round up
+             */
+            if (fits and whole == 0) {
+                return Fixed((UnderlyingType)(half ? 1 : 0));
+            }
+            uint32_t limit = parts.negative ? detail::magnitude(Traits::MIN) : detail::magnitude(Traits::MAX);
+            if (not fits or whole > limit or (half and whole == limit)) {
+                return parts.negative ? Fixed::MIN() : Fixed::MAX();
+            }
+            uint32_t magnitude = whole + (half ? 1u : 0u);
+            return Fixed((UnderlyingType)(parts.negative ? 0u - magnitude : magnitude));
+        }
+
         UnderlyingType _raw_value;
     };
 
-    constexpr PSXFixed operator"" _fx(long double literal) {
-        return PSXFixed((double)literal);
+    template <char... Literal>
+    consteval PSXFixed operator"" _fx() {
+        return PSXFixed::from_literal<Literal...>();
     }
 
-    constexpr PSXFixed operator"" _fx(unsigned long long int literal) {
-        return PSXFixed::from_integer((PSXFixed::UnderlyingType)literal);
+    template <char... Literal>
+    consteval PSXFixed16 operator"" _fx16() {
+        return PSXFixed16::from_literal<Literal...>();
     }
 }
 
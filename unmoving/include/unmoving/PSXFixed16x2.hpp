@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @brief This file forms part of Unmoving
+ * @details Provides PSXFixed16x2, a pair of PSXFixed16 values packed into a
+ * single 32-bit word, so that both can be operated on with the same
+ * instructions ("SIMD within a register"). The PlayStation has no SIMD
+ * instructions, but many of the operations done on 2D coordinates and texture
+ * UVs can be done on both of their components at once in this way, taking
+ * half the instructions of doing them one at a time.
+ *
+ * @author Joshua Saxby <joshua.a.saxby@gmail.com>
+ * @date September 2021
+ *
+ * @copyright Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_UNMOVING_PSX_FIXED_16X2_HPP
+#define COM_SAXBOPHONE_UNMOVING_PSX_FIXED_16X2_HPP
+
+#include "PSXFixed.hpp"
+
+namespace unmoving {
+    /**
+     * @brief Two PSXFixed16 values packed into one 32-bit word
+     * @details The low lane is stored in the low 16 bits of the word and the
+     * high lane in the high 16 bits. Arithmetic is done on both lanes at once
+     * with 32-bit integer instructions, masking off the carries and borrows
+     * which would otherwise cross from the low lane into the high lane, so
+     * that each lane gives exactly the same result as the corresponding
+     * PSXFixed16 operator, including wrapping on overflow.
+     * @note Only the operations which can be done on both lanes at once are
+     * provided. To do anything else, unpack the lanes with
+     * PSXFixed16x2::low() and PSXFixed16x2::high().
+     */
+    class PSXFixed16x2 {
+    public:
+        /**
+         * @brief Underlying base type the pair of fixed-point integers is stored as
+         */
+        using UnderlyingType = uint32_t;
+        /**
+         * @brief Default constructor, creates a PSXFixed16x2 instance with
+         * both lanes set to `0.0_fx`
+         */
+        constexpr PSXFixed16x2() : _raw_value(0) {}
+        /**
+         * @brief Implicit converting constructor from a packed word
+         * @details Creates a PSXFixed16x2 instance wrapping two raw
+         * fixed-point integers packed into one word, such as a pair of
+         * coordinates or UVs loaded from memory with a single load.
+         */
+        constexpr PSXFixed16x2(UnderlyingType raw_value) : _raw_value(raw_value) {}
+        /**
+         * @brief Packs two PSXFixed16 values into one word
+         */
+        constexpr PSXFixed16x2(PSXFixed16 low, PSXFixed16 high)
+          : _raw_value(
+                (uint32_t)(uint16_t)(PSXFixed16::UnderlyingType)low
+                | ((uint32_t)(uint16_t)(PSXFixed16::UnderlyingType)high << 16)
+            )
+          {}
+        /**
+         * @brief Packs the same PSXFixed16 value into both lanes
+         */
+        static constexpr PSXFixed16x2 splat(PSXFixed16 value) {
+            return PSXFixed16x2((uint32_t)(uint16_t)(PSXFixed16::UnderlyingType)value * 0x00010001u);
+        }
+        /**
+         * @brief Explicit cast operator to underlying type
+         * @note Unlike PSXFixed, this is explicit, as the packed word is not
+         * meaningful as a single integer, and so that the built-in integer
+         * operators aren't mistaken for the lane-wise ones.
+         */
+        explicit constexpr operator UnderlyingType() const {
+            return this->_raw_value;
+        }
+        /**
+         * @returns The value in the low lane
+         */
+        constexpr PSXFixed16 low() const {
+            return PSXFixed16((PSXFixed16::UnderlyingType)(uint16_t)this->_raw_value);
+        }
+        /**
+         * @returns The value in the high lane
+         */
+        constexpr PSXFixed16 high() const {
+            return PSXFixed16((PSXFixed16::UnderlyingType)(uint16_t)(this->_raw_value >> 16));
+        }
+        /**
+         * @brief Unpacks both lanes at once
+         * @param[out] low set to the value in the low lane
+         * @param[out] high set to the value in the high lane
+         */
+        constexpr void unpack(PSXFixed16& low, PSXFixed16& high) const {
+            low = this->low();
+            high = this->high();
+        }
+        /**
+         * @brief Compound assignment addition operator
+         * @details Adds the lanes of `rhs` to the corresponding lanes of this
+         * value, wrapping each one on overflow.
+         */
+        constexpr PSXFixed16x2& operator +=(const PSXFixed16x2& rhs) {
+            // add all but the top bit of each lane so no carry crosses lanes, then put the top bits back
+            uint32_t sum = (this->_raw_value & ~PSXFixed16x2::TOP_BITS) + (rhs._raw_value & ~PSXFixed16x2::TOP_BITS);
+            this->_raw_value = sum ^ ((this->_raw_value ^ rhs._raw_value) & PSXFixed16x2::TOP_BITS);
+            return *this;
+        }
+        /**
+         * @brief Compound assignment subtraction operator
+         * @details Subtracts the lanes of `rhs` from the corresponding lanes
+         * of this value, wrapping each one on overflow.
+         */
+        constexpr PSXFixed16x2& operator -=(const PSXFixed16x2& rhs) {
+            // set the top bit of each lane so no borrow crosses lanes, then fix the top bits up
+            uint32_t difference = (this->_raw_value | PSXFixed16x2::TOP_BITS) - (rhs._raw_value & ~PSXFixed16x2::TOP_BITS);
+            this->_raw_value = difference ^ ((this->_raw_value ^ ~rhs._raw_value) & PSXFixed16x2::TOP_BITS);
+            return *this;
+        }
+        /**
+         * @brief Compound assignment left-shift operator
+         * @details Multiplies both lanes by `2**shift`, wrapping each one on
+         * overflow.
+         * @param shift must be in the range `[0..15]`
+         */
+        constexpr PSXFixed16x2& operator <<=(size_t shift) {
+            // drop the bits shifted out of the low lane into the high lane
+            uint32_t lane_mask = (0xFFFFu << shift) & 0xFFFFu;
+            this->_raw_value = (this->_raw_value << shift) & (lane_mask | (lane_mask << 16));
+            return *this;
+        }
+        /**
+         * @brief Compound assignment right-shift operator
+         * @details Divides both lanes by `2**shift`, rounding towards negative
+         * infinity as an arithmetic right-shift does.
+         * @param shift must be in the range `[0..15]`
+         */
+        constexpr PSXFixed16x2& operator >>=(size_t shift) {
+            // drop the bits shifted out of the high lane into the low lane
+            uint32_t lane_mask = 0xFFFFu >> shift;
+            uint32_t shifted = (this->_raw_value >> shift) & (lane_mask | (lane_mask << 16));
+            // then sign-extend each lane by filling the bits above it with copies of its sign
+            uint32_t signs = this->_raw_value & PSXFixed16x2::TOP_BITS;
+            this->_raw_value = shifted | signs | (signs - (signs >> shift));
+            return *this;
+        }
+        /**
+         * @brief Equality operator, true when both lanes are equal
+         */
+        constexpr bool operator==(const PSXFixed16x2& rhs) const = default;
+        /**
+         * @brief Unary minus (negation) operator
+         */
+        constexpr PSXFixed16x2 operator-() const {
+            return PSXFixed16x2() - *this;
+        }
+        /**
+         * @brief Addition operator
+         */
+        constexpr friend PSXFixed16x2 operator+(PSXFixed16x2 lhs, const PSXFixed16x2& rhs) {
+            lhs += rhs;
+            return lhs;
+        }
+        /**
+         * @brief Subtraction operator
+         */
+        constexpr friend PSXFixed16x2 operator-(PSXFixed16x2 lhs, const PSXFixed16x2& rhs) {
+            lhs -= rhs;
+            return lhs;
+        }
+        /**
+         * @brief Left-shift operator
+         */
+        constexpr friend PSXFixed16x2 operator<<(PSXFixed16x2 lhs, size_t shift) {
+            lhs <<= shift;
+            return lhs;
+        }
+        /**
+         * @brief Right-shift operator
+         */
+        constexpr friend PSXFixed16x2 operator>>(PSXFixed16x2 lhs, size_t shift) {
+            lhs >>= shift;
+            return lhs;
+        }
+        /**
+         * @returns A mask with all bits of each lane set where the lanes of
+         * `lhs` and `rhs` are equal, and all clear where they are not
+         */
+        static constexpr uint32_t equal_mask(const PSXFixed16x2& lhs, const PSXFixed16x2& rhs) {
+            uint32_t difference = lhs._raw_value ^ rhs._raw_value;
+            // the top bit of each lane is set if any bit of the lane is set, without carrying across lanes
+            uint32_t nonzero = (((difference & ~PSXFixed16x2::TOP_BITS) + ~PSXFixed16x2::TOP_BITS) | difference)
+                & PSXFixed16x2::TOP_BITS;
+            return ~PSXFixed16x2::spread_top_bits(nonzero);
+        }
+        /**
+         * @returns A mask with all bits of each lane set where the lane of
+         * `lhs` is less than the lane of `rhs`, and all clear where it is not
+         */
+        static constexpr uint32_t less_mask(const PSXFixed16x2& lhs, const PSXFixed16x2& rhs) {
+            uint32_t difference = (lhs - rhs)._raw_value;
+            // the sign of the difference, corrected for the lanes where the subtraction overflowed
+            uint32_t less = difference ^ ((lhs._raw_value ^ rhs._raw_value) & (difference ^ lhs._raw_value));
+            return PSXFixed16x2::spread_top_bits(less & PSXFixed16x2::TOP_BITS);
+        }
+        /**
+         * @returns The lanes of `if_set` where the lanes of `mask` are set,
+         * and the lanes of `if_clear` where they are clear.
+         * @param mask a mask such as that returned by PSXFixed16x2::equal_mask()
+         * or PSXFixed16x2::less_mask()
+         * @param if_set value to take the lanes of where `mask` is set
+         * @param if_clear value to take the lanes of where `mask` is clear
+         */
+        static constexpr PSXFixed16x2 select(uint32_t mask, const PSXFixed16x2& if_set, const PSXFixed16x2& if_clear) {
+            return PSXFixed16x2((if_set._raw_value & mask) | (if_clear._raw_value & ~mask));
+        }
+
+    private:
+        // the top (sign) bit of each lane
+        static constexpr uint32_t TOP_BITS = 0x80008000u;
+
+        // sets all bits of each lane whose top bit is set, where only the top bits are set in value
+        static constexpr uint32_t spread_top_bits(uint32_t value) {
+            return (value - (value >> 15)) | value;
+        }
+
+        UnderlyingType _raw_value;
+    };
+}
+
+#endif // include guard
@@ -0,0 +1,479 @@
+/**
+ * @file
+ * @brief This file forms part of Unmoving
+ * @details Provides arithmetic and conversions on whole arrays of PSXFixed
+ * values at once, for tools which process large amounts of fixed-point data
+ * ahead of time, such as asset baking tools. On x86 build machines, the
+ * arrays are processed with SSE2 or AVX2 instructions, if the compiler has
+ * been told that it may use them (e.g. with `-msse2` or `-mavx2`). Otherwise
+ * (including on the PlayStation), they are processed one value at a time with
+ * the PSXFixed operators.
+ * @note Whichever way they are processed, the results are bit-identical to
+ * those of the PSXFixed operators.
+ *
+ * @author Joshua Saxby <joshua.a.saxby@gmail.com>
+ * @date September 2021
+ *
+ * @copyright Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_UNMOVING_BATCH_HPP
+#define COM_SAXBOPHONE_UNMOVING_BATCH_HPP
+
+#include "PSXFixed.hpp"
+
+/**
+ * @def UNMOVING_BATCH_SIMD
+ * @brief Which instruction set the batch functions are vectorised with
+ * @details `2` for AVX2, `1` for SSE2 or `0` for none. Chosen at compile-time
+ * from the instruction sets the compiler has been told it may use.
+ * @note Define it before including this header to override, for instance to
+ * `0` to disable vectorisation.
+ */
+#ifndef UNMOVING_BATCH_SIMD
+#if defined(__AVX2__)
+#define UNMOVING_BATCH_SIMD 2
+// MSVC doesn't define __SSE2__, but SSE2 is always there on x64 and with /arch:SSE2 on x86
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UNMOVING_BATCH_SIMD 1
+#else
+#define UNMOVING_BATCH_SIMD 0
+#endif
+#endif
+
+#if UNMOVING_BATCH_SIMD >= 2
+#include <immintrin.h>
+#elif UNMOVING_BATCH_SIMD >= 1
+#include <emmintrin.h>
+#endif
+
+namespace unmoving {
+    /**
+     * @brief Arithmetic and conversions on arrays of PSXFixed values
+     * @details Each function processes `count` elements of its input arrays,
+     * writing the results to `count` elements of its output array. The output
+     * array may be the same as any of the input arrays, but must not
+     * otherwise overlap them.
+     */
+    namespace batch {
+        /*
+         * implementation details which are not part of the public interface:
+         * kernels which each process detail::WIDTH elements at once, leaving
+         * any left over at the end of the arrays to a scalar loop
+         */
+        namespace detail {
+#if UNMOVING_BATCH_SIMD >= 2
+            using Vector = __m256i;
+            // number of PSXFixed values processed at once
+            inline constexpr size_t WIDTH = 8;
+
+            inline Vector load(const PSXFixed* source) {
+                return _mm256_loadu_si256((const __m256i*)source);
+            }
+
+            inline void store(PSXFixed* destination, Vector value) {
+                _mm256_storeu_si256((__m256i*)destination, value);
+            }
+
+            inline Vector add(Vector lhs, Vector rhs) { return _mm256_add_epi32(lhs, rhs); }
+
+            inline Vector sub(Vector lhs, Vector rhs) { return _mm256_sub_epi32(lhs, rhs); }
+
+            inline Vector broadcast(PSXFixed value) { return _mm256_set1_epi32(value); }
+
+            // the same as the PSXFixed multiplication operator, on the magnitudes for rounding towards zero
+            inline Vector mul(Vector lhs, Vector rhs) {
+                Vector lhs_sign = _mm256_srai_epi32(lhs, 31);
+                Vector rhs_sign = _mm256_srai_epi32(rhs, 31);
+                Vector lhs_magnitude = _mm256_sub_epi32(_mm256_xor_si256(lhs, lhs_sign), lhs_sign);
+                Vector rhs_magnitude = _mm256_sub_epi32(_mm256_xor_si256(rhs, rhs_sign), rhs_sign);
+                // full products of the even lanes, and of the odd lanes, shifted so the results land in place
+                Vector even = _mm256_srli_epi64(_mm256_mul_epu32(lhs_magnitude, rhs_magnitude), PSXFixed::FRACTION_BITS);
+                Vector odd = _mm256_slli_epi64(
+                    _mm256_mul_epu32(_mm256_srli_epi64(lhs_magnitude, 32), _mm256_srli_epi64(rhs_magnitude, 32)),
+                    32 - PSXFixed::FRACTION_BITS
+                );
+                Vector low_halves = _mm256_set1_epi64x(0xFFFFFFFF);
+                Vector magnitude = _mm256_or_si256(_mm256_and_si256(even, low_halves), _mm256_andnot_si256(low_halves, odd));
+                Vector negative = _mm256_xor_si256(lhs_sign, rhs_sign);
+                return _mm256_sub_epi32(_mm256_xor_si256(magnitude, negative), negative);
+            }
+
+            // the same as the PSXFixed division operator, except that it gives MIN() where the quotient is out of range
+            inline Vector div(Vector lhs, Vector rhs) {
+                __m256d scale = _mm256_set1_pd(PSXFixed::SCALE);
+                __m128i low = _mm256_cvttpd_epi32(_mm256_div_pd(
+                    _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(lhs)), scale),
+                    _mm256_cvtepi32_pd(_mm256_castsi256_si128(rhs))
+                ));
+                __m128i high = _mm256_cvttpd_epi32(_mm256_div_pd(
+                    _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(lhs, 1)), scale),
+                    _mm256_cvtepi32_pd(_mm256_extracti128_si256(rhs, 1))
+                ));
+                return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+            }
+
+            // whether the fraction part of each of the scaled values is at least one half
+            inline __m128i round_mask(__m256d scaled, __m128i integral) {
+                __m256d remainder = _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_sub_pd(scaled, _mm256_cvtepi32_pd(integral)));
+                __m256d mask = _mm256_cmp_pd(remainder, _mm256_set1_pd(0.5), _CMP_GE_OQ);
+                // the comparison gives a 64-bit mask per lane, so pick out one 32-bit half of each
+                return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+                    _mm256_castpd_si256(mask),
+                    _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)
+                ));
+            }
+
+            inline Vector from_double(__m256d low, __m256d high) {
+                // the same as the PSXFixed converting constructor from double, including how it rounds
+                __m256d scale = _mm256_set1_pd(PSXFixed::SCALE);
+                low = _mm256_mul_pd(low, scale);
+                high = _mm256_mul_pd(high, scale);
+                __m128i low_integral = _mm256_cvttpd_epi32(low);
+                __m128i high_integral = _mm256_cvttpd_epi32(high);
+                Vector round = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(round_mask(low, low_integral)),
+                    round_mask(high, high_integral),
+                    1
+                );
+                Vector integral = _mm256_inserti128_si256(_mm256_castsi128_si256(low_integral), high_integral, 1);
+                // step by one away from zero, going by the sign of the integral part as the constructor does
+                Vector step = _mm256_or_si256(_mm256_srai_epi32(integral, 31), _mm256_set1_epi32(1));
+                return _mm256_add_epi32(integral, _mm256_and_si256(step, round));
+            }
+
+            inline Vector from_float(const float* source) {
+                return from_double(_mm256_cvtps_pd(_mm_loadu_ps(source)), _mm256_cvtps_pd(_mm_loadu_ps(source + 4)));
+            }
+
+            inline Vector from_double(const double* source) {
+                return from_double(_mm256_loadu_pd(source), _mm256_loadu_pd(source + 4));
+            }
+
+            inline void to_double(double* destination, Vector value) {
+                __m256d precision = _mm256_set1_pd(PSXFixed::PRECISION);
+                _mm256_storeu_pd(destination, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(value)), precision));
+                _mm256_storeu_pd(destination + 4, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(value, 1)), precision));
+            }
+#elif UNMOVING_BATCH_SIMD >= 1
+            using Vector = __m128i;
+            // number of PSXFixed values processed at once
+            inline constexpr size_t WIDTH = 4;
+
+            inline Vector load(const PSXFixed* source) {
+                return _mm_loadu_si128((const __m128i*)source);
+            }
+
+            inline void store(PSXFixed* destination, Vector value) {
+                _mm_storeu_si128((__m128i*)destination, value);
+            }
+
+            inline Vector add(Vector lhs, Vector rhs) { return _mm_add_epi32(lhs, rhs); }
+
+            inline Vector sub(Vector lhs, Vector rhs) { return _mm_sub_epi32(lhs, rhs); }
+
+            inline Vector broadcast(PSXFixed value) { return _mm_set1_epi32(value); }
+
+            // the same as the PSXFixed multiplication operator, on the magnitudes for rounding towards zero
+            inline Vector mul(Vector lhs, Vector rhs) {
+                Vector lhs_sign = _mm_srai_epi32(lhs, 31);
+                Vector rhs_sign = _mm_srai_epi32(rhs, 31);
+                Vector lhs_magnitude = _mm_sub_epi32(_mm_xor_si128(lhs, lhs_sign), lhs_sign);
+                Vector rhs_magnitude = _mm_sub_epi32(_mm_xor_si128(rhs, rhs_sign), rhs_sign);
+                // full products of the even lanes, and of the odd lanes, shifted so the results land in place
+                Vector even = _mm_srli_epi64(_mm_mul_epu32(lhs_magnitude, rhs_magnitude), PSXFixed::FRACTION_BITS);
+                Vector odd = _mm_slli_epi64(
+                    _mm_mul_epu32(_mm_srli_epi64(lhs_magnitude, 32), _mm_srli_epi64(rhs_magnitude, 32)),
+                    32 - PSXFixed::FRACTION_BITS
+                );
+                Vector low_halves = _mm_set1_epi64x(0xFFFFFFFF);
+                Vector magnitude = _mm_or_si128(_mm_and_si128(even, low_halves), _mm_andnot_si128(low_halves, odd));
+                Vector negative = _mm_xor_si128(lhs_sign, rhs_sign);
+                return _mm_sub_epi32(_mm_xor_si128(magnitude, negative), negative);
+            }
+
+            // the same as the PSXFixed division operator, except that it gives MIN() where the quotient is out of range
+            inline Vector div(Vector lhs, Vector rhs) {
+                __m128d scale = _mm_set1_pd(PSXFixed::SCALE);
+                // each conversion to double handles the lower two lanes only
+                __m128i low = _mm_cvttpd_epi32(_mm_div_pd(
+                    _mm_mul_pd(_mm_cvtepi32_pd(lhs), scale),
+                    _mm_cvtepi32_pd(rhs)
+                ));
+                __m128i high = _mm_cvttpd_epi32(_mm_div_pd(
+                    _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(lhs, 8)), scale),
+                    _mm_cvtepi32_pd(_mm_srli_si128(rhs, 8))
+                ));
+                return _mm_unpacklo_epi64(low, high);
+            }
+
+            inline Vector from_double(__m128d low, __m128d high) {
+                // the same as the PSXFixed converting constructor from double, including how it rounds
+                __m128d scale = _mm_set1_pd(PSXFixed::SCALE);
+                low = _mm_mul_pd(low, scale);
+                high = _mm_mul_pd(high, scale);
+                __m128i low_integral = _mm_cvttpd_epi32(low);
+                __m128i high_integral = _mm_cvttpd_epi32(high);
+                __m128d sign_bit = _mm_set1_pd(-0.0);
+                __m128d half = _mm_set1_pd(0.5);
+                __m128d low_round = _mm_cmpge_pd(_mm_andnot_pd(sign_bit, _mm_sub_pd(low, _mm_cvtepi32_pd(low_integral))), half);
+                __m128d high_round = _mm_cmpge_pd(_mm_andnot_pd(sign_bit, _mm_sub_pd(high, _mm_cvtepi32_pd(high_integral))), half);
+                // the comparison gives a 64-bit mask per lane, so pick out one 32-bit half of each
+                Vector round = _mm_castps_si128(_mm_shuffle_ps(
+                    _mm_castpd_ps(low_round),
+                    _mm_castpd_ps(high_round),
+                    _MM_SHUFFLE(2, 0, 2, 0)
+                ));
+                Vector integral = _mm_unpacklo_epi64(low_integral, high_integral);
+                // step by one away from zero, going by the sign of the integral part as the constructor does
+                Vector step = _mm_or_si128(_mm_srai_epi32(integral, 31), _mm_set1_epi32(1));
+                return _mm_add_epi32(integral, _mm_and_si128(step, round));
+            }
+
+            inline Vector from_float(const float* source) {
+                __m128 values = _mm_loadu_ps(source);
+                return from_double(_mm_cvtps_pd(values), _mm_cvtps_pd(_mm_movehl_ps(values, values)));
+            }
+
+            inline Vector from_double(const double* source) {
+                return from_double(_mm_loadu_pd(source), _mm_loadu_pd(source + 2));
+            }
+
+            inline void to_double(double* destination, Vector value) {
+                __m128d precision = _mm_set1_pd(PSXFixed::PRECISION);
+                _mm_storeu_pd(destination, _mm_mul_pd(_mm_cvtepi32_pd(value), precision));
+                _mm_storeu_pd(destination + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(value, 8)), precision));
+            }
+#endif
+        }
+
+        /**
+         * @brief Adds each element of `rhs` to the corresponding element of `lhs`
+         */
+        inline void add(const PSXFixed* lhs, const PSXFixed* rhs, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::store(out + i, detail::add(detail::load(lhs + i), detail::load(rhs + i)));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = lhs[i] + rhs[i];
+            }
+        }
+
+        /**
+         * @brief Subtracts each element of `rhs` from the corresponding element of `lhs`
+         */
+        inline void sub(const PSXFixed* lhs, const PSXFixed* rhs, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::store(out + i, detail::sub(detail::load(lhs + i), detail::load(rhs + i)));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = lhs[i] - rhs[i];
+            }
+        }
+
+        /**
+         * @brief Multiplies each element of `lhs` by the corresponding element of `rhs`
+         */
+        inline void mul(const PSXFixed* lhs, const PSXFixed* rhs, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::store(out + i, detail::mul(detail::load(lhs + i), detail::load(rhs + i)));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = lhs[i] * rhs[i];
+            }
+        }
+
+        /**
+         * @brief Divides each element of `lhs` by the corresponding element of `rhs`
+         * @warning As with the division operator, the elements of `rhs` must not be zero.
+         */
+        inline void div(const PSXFixed* lhs, const PSXFixed* rhs, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            /*
+             * the quotient is computed exactly in double, as the numerator
+             * always fits in its mantissa and the quotient is never close
+             * enough to an integer to be rounded onto it
+             */
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                PSXFixed quotients[detail::WIDTH];
+                detail::store(quotients, detail::div(detail::load(lhs + i), detail::load(rhs + i)));
+                // quotients which are out of range (rare) wrap around, so are redone one at a time
+                for (size_t j = 0; j < detail::WIDTH; j++) {
+                    if (quotients[j] == PSXFixed::MIN()) {
+                        quotients[j] = lhs[i + j] / rhs[i + j];
+                    }
+                }
+                // only written once all of the inputs have been read, in case out is the same array as them
+                for (size_t j = 0; j < detail::WIDTH; j++) {
+                    out[i + j] = quotients[j];
+                }
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = lhs[i] / rhs[i];
+            }
+        }
+
+        /**
+         * @brief Multiplies each element of `in` by `factor`
+         */
+        inline void scale(const PSXFixed* in, PSXFixed factor, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            detail::Vector factors = detail::broadcast(factor);
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::store(out + i, detail::mul(detail::load(in + i), factors));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = in[i] * factor;
+            }
+        }
+
+        /**
+         * @brief The result of batch::from_chars()
+         */
+        struct FromCharsResult {
+            /** @brief Where parsing stopped: the end of the range, after the last value, or at the value which couldn't be parsed */
+            const char* ptr;
+            /** @brief Why the value at `ptr` couldn't be parsed, if one couldn't */
+            FromCharsError error;
+            /** @brief The number of values parsed */
+            size_t count;
+        };
+
+        /**
+         * @brief Parses a list of decimal numbers from a range of characters
+         * @details The numbers may be separated (and preceded and followed)
+         * by any mixture of whitespace and commas, and are each parsed the
+         * same way as by PSXFixed::from_chars(), in one pass over the range.
+         * Parsing stops at the end of the range, when `capacity` values have
+         * been parsed, or at the first value which can't be parsed (or which
+         * is followed by anything other than a separator).
+         * @b Usage:
+         * @code
+         * const char text[] = "1.5, -2.25, 3\n4.0";
+         * PSXFixed values[4];
+         * batch::FromCharsResult result = batch::from_chars(text, text + sizeof(text) - 1, values, 4);
+         * @endcode
+         */
+        inline FromCharsResult from_chars(const char* first, const char* last, PSXFixed* out, size_t capacity) {
+            auto is_separator = [](char character) {
+                return character == ' ' or character == '\t' or character == '\n' or character == '\r' or character == ',';
+            };
+            size_t count = 0;
+            while (true) {
+                while (first != last and is_separator(*first)) {
+                    first++;
+                }
+                if (first == last or count == capacity) {
+                    return {first, FromCharsError::NONE, count};
+                }
+                unmoving::FromCharsResult result = PSXFixed::from_chars(first, last, out[count]);
+                if (result.error != FromCharsError::NONE) {
+                    return {first, result.error, count};
+                }
+                first = result.ptr;
+                count++;
+                // each value must be followed by a separator, so "1.5x" is an error rather than 1.5 then "x"
+                if (first != last and not is_separator(*first)) {
+                    return {first, FromCharsError::INVALID, count};
+                }
+            }
+        }
+
+        // conversions with floating point, which PSXFixed only allows at compile-time with UNMOVING_CONSTEVAL_FLOAT
+#if UNMOVING_CONSTEVAL_FLOAT == 0
+        /**
+         * @brief Converts each element of `in` to the nearest PSXFixed value
+         * @warning The elements of `in` must be within the range of PSXFixed.
+         */
+        inline void from_float(const float* in, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::store(out + i, detail::from_float(in + i));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = PSXFixed((double)in[i]);
+            }
+        }
+
+        /**
+         * @brief Converts each element of `in` to the nearest PSXFixed value
+         * @warning The elements of `in` must be within the range of PSXFixed.
+         */
+        inline void from_double(const double* in, PSXFixed* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::store(out + i, detail::from_double(in + i));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = PSXFixed(in[i]);
+            }
+        }
+#endif
+
+        /**
+         * @brief Converts each element of `in`, the bits of an IEEE-754
+         * single-precision float, to the nearest PSXFixed value
+         * @details The same as PSXFixed::from_float_bits(), for converting
+         * float data as it is loaded on the PlayStation. This is only ever
+         * processed one value at a time, as it only takes a few integer
+         * operations per value.
+         */
+        inline void from_float_bits(const uint32_t* in, PSXFixed* out, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = PSXFixed::from_float_bits(in[i]);
+            }
+        }
+
+        /**
+         * @brief Converts each element of `in`, the bits of an IEEE-754
+         * double-precision float, to the nearest PSXFixed value
+         * @details The same as PSXFixed::from_double_bits(), one value at a time.
+         */
+        inline void from_double_bits(const uint64_t* in, PSXFixed* out, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = PSXFixed::from_double_bits(in[i]);
+            }
+        }
+
+#if UNMOVING_CONSTEVAL_FLOAT == 0
+        /**
+         * @brief Converts each element of `in` to double exactly
+         */
+        inline void to_double(const PSXFixed* in, double* out, size_t count) {
+            size_t i = 0;
+#if UNMOVING_BATCH_SIMD
+            for (; i + detail::WIDTH <= count; i += detail::WIDTH) {
+                detail::to_double(out + i, detail::load(in + i));
+            }
+#endif
+            for (; i < count; i++) {
+                out[i] = (double)in[i];
+            }
+        }
+#endif
+    }
+}
+
+#endif // include guard
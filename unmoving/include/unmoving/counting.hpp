@@ -0,0 +1,581 @@
+/**
+ * @file
+ * @brief This file forms part of Unmoving
+ * @details Provides Counted, a drop-in replacement for PSXFixed (or any other
+ * Fixed) which counts the operations done with it, and CountingScope, which
+ * collects the counts for a part of a program and estimates how many cycles
+ * of the PlayStation's CPU they would take. This is for prototyping on a
+ * desktop computer, to find out early when an algorithm does too many
+ * divisions or conversions to fit in a frame on the PlayStation.
+ *
+ * Counting is only done when #UNMOVING_COUNT_OPERATIONS is `1`. Otherwise,
+ * Counted<T> is just `T` and CountingScope does nothing, so that there is no
+ * overhead at all.
+ *
+ * @author Joshua Saxby <joshua.a.saxby@gmail.com>
+ * @date October 2021
+ *
+ * @copyright Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_UNMOVING_COUNTING_HPP
+#define COM_SAXBOPHONE_UNMOVING_COUNTING_HPP
+
+#include "PSXFixed.hpp"
+
+/**
+ * @def UNMOVING_COUNT_OPERATIONS
+ * @brief Whether Counted values count the operations done with them
+ * @details When this is `1`, Counted<T> wraps `T`, adding every operation
+ * done with it to the innermost CountingScope. When this is `0`, Counted<T>
+ * is the same type as `T` and CountingScope does nothing.
+ * @note Defaults to `0`. Define it before including this header to override.
+ */
+#ifndef UNMOVING_COUNT_OPERATIONS
+#define UNMOVING_COUNT_OPERATIONS 0
+#endif
+
+namespace unmoving {
+    namespace detail {
+        // writes text into [position, end), setting position to null if it doesn't fit
+        struct TextWriter {
+            char* position;
+            char* end;
+
+            constexpr void text(const char* string) {
+                for (; *string != '\0'; string++) {
+                    if (position == nullptr) { return; }
+                    if (position == end) {
+                        position = nullptr;
+                        return;
+                    }
+                    *position++ = *string;
+                }
+            }
+
+            constexpr void number(uint32_t value) {
+                size_t digits = count_digits(value);
+                if (position == nullptr) { return; }
+                if ((size_t)(end - position) < digits) {
+                    position = nullptr;
+                    return;
+                }
+                position += digits;
+                write_digits(position, value, digits);
+            }
+        };
+    }
+
+    /**
+     * @brief The kinds of operations counted by Counted
+     * @note Comparisons aren't counted, as they are the same as comparing
+     * integers.
+     */
+    enum class CountedOperation {
+        ADDITION,       /**< Addition, subtraction, negation, increment and decrement */
+        MULTIPLICATION, /**< Multiplication by a fixed-point value or an integer */
+        DIVISION,       /**< Division by a fixed-point value or an integer */
+        CONVERSION,     /**< Conversion from or to `double`, `float` or an integer value */
+        FORMATTING,     /**< Conversion from or to text */
+    };
+
+    /** @brief How many kinds of CountedOperation there are */
+    inline constexpr size_t COUNTED_OPERATION_KINDS = 5;
+
+    /**
+     * @brief Estimated cycles each kind of operation takes, and how many
+     * cycles there are in a frame
+     * @details R3000() gives rough figures for the PlayStation. For better
+     * ones, count the instructions each operation takes with the
+     * `run-instruction-counts` target of the benchmarks.
+     */
+    struct CycleTable {
+        /** @brief Cycles per operation, indexed by CountedOperation */
+        uint32_t cycles[COUNTED_OPERATION_KINDS];
+        /** @brief Cycles in a frame */
+        uint32_t frame_cycles;
+
+        /**
+         * @brief Rough cycle counts for the PlayStation's R3000 at 33.8688MHz,
+         * with 60 frames per second (NTSC)
+         * @details Multiplication is dominated by the `MULTU` instruction
+         * (about 13 cycles) and division by two `DIVU` instructions (about 36
+         * cycles each). Conversions from or to floating-point are done in
+         * software, as the PlayStation has no floating-point unit.
+         */
+        static constexpr CycleTable R3000() {
+            return {{2, 30, 100, 150, 400}, 33'868'800 / 60};
+        }
+
+        /** @brief Cycles for one operation of kind `operation` */
+        constexpr uint32_t operator[](CountedOperation operation) const {
+            return this->cycles[(size_t)operation];
+        }
+    };
+
+    /**
+     * @brief How many of each kind of operation have been done
+     */
+    struct OperationCounts {
+        /** @brief Counts, indexed by CountedOperation */
+        uint32_t counts[COUNTED_OPERATION_KINDS] = {};
+
+        /** @brief How many operations of kind `operation` have been done */
+        constexpr uint32_t operator[](CountedOperation operation) const {
+            return this->counts[(size_t)operation];
+        }
+
+        /** @brief Adds the counts of `other` to these */
+        constexpr OperationCounts& operator+=(const OperationCounts& other) {
+            for (size_t i = 0; i < COUNTED_OPERATION_KINDS; i++) {
+                this->counts[i] += other.counts[i];
+            }
+            return *this;
+        }
+
+        /**
+         * @returns The estimated cycles the operations take, according to
+         * `table`
+         * @note Saturates at the largest `uint32_t`, which is about two
+         * minutes of the PlayStation's time.
+         */
+        constexpr uint32_t estimated_cycles(const CycleTable& table = CycleTable::R3000()) const {
+            uint32_t total = 0;
+            for (size_t i = 0; i < COUNTED_OPERATION_KINDS; i++) {
+                detail::DoubleWord product = detail::multiply_u32(this->counts[i], table.cycles[i]);
+                if (product.hi != 0 or product.lo > 0xFFFFFFFFu - total) { return 0xFFFFFFFFu; }
+                total += product.lo;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Writes a report of the counts and estimated cycles to a
+         * null-terminated string, such as:
+         * @code
+         * additions: 120 x 2 = 240 cycles
+         * multiplications: 48 x 30 = 1440 cycles
+         * divisions: 8 x 100 = 800 cycles
+         * conversions: 0 x 150 = 0 cycles
+         * formatting: 1 x 400 = 400 cycles
+         * total: 2880 cycles, 0.51% of a frame
+         * @endcode
+         * @returns `false` (writing an empty string if `buffer_size` isn't
+         * zero) if `buffer` isn't big enough, otherwise `true`
+         * @note 400 characters is always enough.
+         */
+        constexpr bool report(char* buffer, size_t buffer_size, const CycleTable& table = CycleTable::R3000()) const {
+            if (buffer == nullptr or buffer_size == 0) { return false; }
+            constexpr const char* NAMES[COUNTED_OPERATION_KINDS] = {
+                "additions", "multiplications", "divisions", "conversions", "formatting",
+            };
+            // leaving room for the null-terminator
+            detail::TextWriter writer = {buffer, buffer + buffer_size - 1};
+            for (size_t i = 0; i < COUNTED_OPERATION_KINDS; i++) {
+                writer.text(NAMES[i]);
+                writer.text(": ");
+                writer.number(this->counts[i]);
+                writer.text(" x ");
+                writer.number(table.cycles[i]);
+                writer.text(" = ");
+                OperationCounts only_these;
+                only_these.counts[i] = this->counts[i];
+                writer.number(only_these.estimated_cycles(table));
+                writer.text(" cycles\n");
+            }
+            uint32_t total = this->estimated_cycles(table);
+            writer.text("total: ");
+            writer.number(total);
+            writer.text(" cycles");
+            // in hundredths of a percent
+            uint32_t share = 0;
+            if (table.frame_cycles != 0 and detail::multiply_divide_u32(total, 10'000, table.frame_cycles, 0xFFFFFFFFu, share)) {
+                writer.text(", ");
+                writer.number(share / 100);
+                writer.text(share % 100 < 10 ? ".0" : ".");
+                writer.number(share % 100);
+                writer.text("% of a frame");
+            }
+            writer.text("\n");
+            if (writer.position == nullptr) {
+                *buffer = '\0';
+                return false;
+            }
+            *writer.position = '\0';
+            return true;
+        }
+    };
+
+#if UNMOVING_COUNT_OPERATIONS
+    /**
+     * @brief Counts the operations done with Counted values while it exists
+     * @details Scopes nest: operations are counted by the innermost scope,
+     * and its counts are added to those of the scope around it when it is
+     * destroyed, so that a scope for a whole frame includes the counts of any
+     * scopes inside it. Each thread has its own scopes.
+     * @b Usage:
+     * @code
+     * CountingScope frame;
+     * update_physics();
+     * char report[256];
+     * frame.report(report, sizeof(report));
+     * printf("%s", report);
+     * @endcode
+     */
+    class CountingScope {
+    public:
+        CountingScope() : _parent(CountingScope::_current) {
+            CountingScope::_current = this;
+        }
+
+        CountingScope(const CountingScope&) = delete;
+        CountingScope& operator=(const CountingScope&) = delete;
+
+        ~CountingScope() {
+            CountingScope::_current = this->_parent;
+            if (this->_parent != nullptr) {
+                this->_parent->_counts += this->_counts;
+            }
+        }
+
+        /** @returns The operations counted so far */
+        const OperationCounts& counts() const {
+            return this->_counts;
+        }
+
+        /** @returns The estimated cycles of the operations counted so far */
+        uint32_t estimated_cycles(const CycleTable& table = CycleTable::R3000()) const {
+            return this->_counts.estimated_cycles(table);
+        }
+
+        /** @brief Writes a report of the operations counted so far, see OperationCounts::report() */
+        bool report(char* buffer, size_t buffer_size, const CycleTable& table = CycleTable::R3000()) const {
+            return this->_counts.report(buffer, buffer_size, table);
+        }
+
+        /** @brief Adds an operation to the innermost scope, if there is one */
+        static void count(CountedOperation operation) {
+            if (CountingScope::_current != nullptr) {
+                CountingScope::_current->_counts.counts[(size_t)operation]++;
+            }
+        }
+
+    private:
+        static inline thread_local CountingScope* _current = nullptr;
+        CountingScope* _parent;
+        OperationCounts _counts;
+    };
+
+    /**
+     * @brief A drop-in replacement for `T` (a Fixed type) which counts the
+     * operations done with it in the innermost CountingScope
+     * @details Arithmetic (including the fused and constant arithmetic,
+     * reciprocals and Fixed::Accumulator), conversions and conversions from or
+     * to text are counted. Any other members of `T` can be used too, but
+     * aren't counted.
+     * @note The free functions of roots.hpp, exponential.hpp and
+     * trigonometry.hpp take and return PSXFixed, so they can be used with
+     * CountedPSXFixed but aren't counted, so scopes which use them
+     * underestimate the cycles taken.
+     * @b Usage:
+     * @code
+     * CountedPSXFixed speed = 1.5_fx;
+     * CountedPSXFixed distance = speed * time; // counted as a multiplication
+     * @endcode
+     */
+    template <typename T>
+    class Counted : public T {
+    private:
+        using Operation = CountedOperation;
+
+    public:
+        /** @brief Underlying base type the fixed-point integer is stored as */
+        using UnderlyingType = typename T::UnderlyingType;
+
+        /** @brief Default constructor, creates a Counted instance with value `0.0` */
+        constexpr Counted() {}
+        /** @brief Implicit converting constructor from a raw value */
+        constexpr Counted(UnderlyingType raw_value) : T(raw_value) {}
+        /** @brief Implicit converting constructor from `T`, which isn't counted */
+        constexpr Counted(const T& value) : T(value) {}
+        // conversions with floating point, which Fixed only allows at compile-time with UNMOVING_CONSTEVAL_FLOAT
+#if UNMOVING_CONSTEVAL_FLOAT == 0
+        /** @brief Implicit converting constructor from `double`, counted as a conversion */
+        Counted(double value) : T(value) {
+            CountingScope::count(Operation::CONVERSION);
+        }
+#endif
+        /** @brief Integer conversion, counted as a conversion */
+        static Counted from_integer(int value) {
+            CountingScope::count(Operation::CONVERSION);
+            return T::from_integer(value);
+        }
+#if UNMOVING_CONSTEVAL_FLOAT == 0
+        /** @brief Cast operator to `double`, counted as a conversion */
+        explicit operator double() const {
+            CountingScope::count(Operation::CONVERSION);
+            return (double)(const T&)*this;
+        }
+        /** @brief Cast operator to `float`, counted as a conversion */
+        explicit operator float() const {
+            CountingScope::count(Operation::CONVERSION);
+            return (float)(const T&)*this;
+        }
+#endif
+        /** @brief See Fixed::from_ratio(), counted as a division */
+        static Counted from_ratio(int numerator, int denominator) {
+            CountingScope::count(Operation::DIVISION);
+            return T::from_ratio(numerator, denominator);
+        }
+        /** @brief See Fixed::from_float_bits(), counted as a conversion */
+        static Counted from_float_bits(uint32_t bits) {
+            CountingScope::count(Operation::CONVERSION);
+            return T::from_float_bits(bits);
+        }
+        /** @brief See Fixed::from_double_bits(), counted as a conversion */
+        static Counted from_double_bits(uint64_t bits) {
+            CountingScope::count(Operation::CONVERSION);
+            return T::from_double_bits(bits);
+        }
+        /** @brief Integer conversion, counted as a conversion */
+        UnderlyingType to_integer() const {
+            CountingScope::count(Operation::CONVERSION);
+            return T::to_integer();
+        }
+        /** @brief See Fixed::to_chars(), counted as formatting */
+        ToCharsResult to_chars(char* first, char* last) const {
+            CountingScope::count(Operation::FORMATTING);
+            return T::to_chars(first, last);
+        }
+        /** @brief See Fixed::to_chars(), counted as formatting */
+        ToCharsResult to_chars(char* first, char* last, size_t precision) const {
+            CountingScope::count(Operation::FORMATTING);
+            return T::to_chars(first, last, precision);
+        }
+        /** @brief See Fixed::to_shortest_chars(), counted as formatting */
+        ToCharsResult to_shortest_chars(char* first, char* last) const {
+            CountingScope::count(Operation::FORMATTING);
+            return T::to_shortest_chars(first, last);
+        }
+        /** @brief See Fixed::from_chars(), counted as formatting */
+        static FromCharsResult from_chars(const char* first, const char* last, Counted& value) {
+            CountingScope::count(Operation::FORMATTING);
+            return T::from_chars(first, last, (T&)value);
+        }
+        /** @brief See Fixed::to_c_str(), counted as formatting */
+        bool to_c_str(char* buffer, size_t buffer_size) const {
+            CountingScope::count(Operation::FORMATTING);
+            return T::to_c_str(buffer, buffer_size);
+        }
+        /**
+         * @brief See Fixed::reciprocal(), counted as a division
+         * @details Multiplying a Counted by the result is counted as a
+         * multiplication.
+         */
+        typename T::Reciprocal reciprocal() const {
+            CountingScope::count(Operation::DIVISION);
+            return T::reciprocal();
+        }
+        /** @brief See Fixed::fast_div(), counted as a division and a multiplication, as it uses the reciprocal */
+        Counted fast_div(const T& divisor) const {
+            CountingScope::count(Operation::DIVISION);
+            CountingScope::count(Operation::MULTIPLICATION);
+            return T::fast_div(divisor);
+        }
+        /** @brief See Fixed::mul_div(), counted as a multiplication and a division */
+        static Counted mul_div(const T& a, const T& b, const T& c, bool* overflow = nullptr) {
+            CountingScope::count(Operation::MULTIPLICATION);
+            CountingScope::count(Operation::DIVISION);
+            return T::mul_div(a, b, c, overflow);
+        }
+        /** @brief See Fixed::mul_shift(), counted as a multiplication */
+        static Counted mul_shift(const T& a, const T& b, size_t shift, bool* overflow = nullptr) {
+            CountingScope::count(Operation::MULTIPLICATION);
+            return T::mul_shift(a, b, shift, overflow);
+        }
+        /**
+         * @brief See Fixed::div_by(), counted as a multiplication, as which
+         * most constant divisions are done
+         */
+        template <typename T::Constant DIVISOR>
+        Counted div_by() const {
+            CountingScope::count(Operation::MULTIPLICATION);
+            return T::template div_by<DIVISOR>();
+        }
+        /** @brief See Fixed::mul_by(), counted as a multiplication */
+        template <typename T::Constant MULTIPLIER>
+        Counted mul_by() const {
+            CountingScope::count(Operation::MULTIPLICATION);
+            return T::template mul_by<MULTIPLIER>();
+        }
+        /** @brief Prefix increment operator, counted as an addition */
+        Counted& operator++() {
+            CountingScope::count(Operation::ADDITION);
+            T::operator++();
+            return *this;
+        }
+        /** @brief Prefix decrement operator, counted as an addition */
+        Counted& operator--() {
+            CountingScope::count(Operation::ADDITION);
+            T::operator--();
+            return *this;
+        }
+        /** @brief Postfix increment operator, counted as an addition */
+        Counted operator++(int) {
+            Counted old = *this;
+            ++*this;
+            return old;
+        }
+        /** @brief Postfix decrement operator, counted as an addition */
+        Counted operator--(int) {
+            Counted old = *this;
+            --*this;
+            return old;
+        }
+        /** @brief Compound assignment addition operator, counted as an addition */
+        Counted& operator+=(const T& rhs) {
+            CountingScope::count(Operation::ADDITION);
+            T::operator+=(rhs);
+            return *this;
+        }
+        /** @brief Compound assignment subtraction operator, counted as an addition */
+        Counted& operator-=(const T& rhs) {
+            CountingScope::count(Operation::ADDITION);
+            T::operator-=(rhs);
+            return *this;
+        }
+        /** @brief Compound assignment multiplication operator, counted as a multiplication */
+        Counted& operator*=(const T& rhs) {
+            CountingScope::count(Operation::MULTIPLICATION);
+            T::operator*=(rhs);
+            return *this;
+        }
+        /** @brief Compound assignment integer multiplication operator, counted as a multiplication */
+        Counted& operator*=(const UnderlyingType& rhs) {
+            CountingScope::count(Operation::MULTIPLICATION);
+            T::operator*=(rhs);
+            return *this;
+        }
+        /** @brief Compound assignment division operator, counted as a division */
+        Counted& operator/=(const T& rhs) {
+            CountingScope::count(Operation::DIVISION);
+            T::operator/=(rhs);
+            return *this;
+        }
+        /** @brief Compound assignment integer division operator, counted as a division */
+        Counted& operator/=(const UnderlyingType& rhs) {
+            CountingScope::count(Operation::DIVISION);
+            T::operator/=(rhs);
+            return *this;
+        }
+        /** @brief Unary minus (negation) operator, counted as an addition */
+        Counted operator-() const {
+            CountingScope::count(Operation::ADDITION);
+            return T::operator-();
+        }
+        /*
+         * each binary operator is overloaded for a Counted on either side and
+         * T on the other, so that mixing them isn't ambiguous
+         */
+        /** @brief Addition operator, counted as an addition */
+        friend Counted operator+(Counted lhs, const Counted& rhs) { return lhs += rhs; }
+        /** @brief Addition operator, counted as an addition */
+        friend Counted operator+(Counted lhs, const T& rhs) { return lhs += rhs; }
+        /** @brief Addition operator, counted as an addition */
+        friend Counted operator+(const T& lhs, const Counted& rhs) { return Counted(lhs) += rhs; }
+        /** @brief Subtraction operator, counted as an addition */
+        friend Counted operator-(Counted lhs, const Counted& rhs) { return lhs -= rhs; }
+        /** @brief Subtraction operator, counted as an addition */
+        friend Counted operator-(Counted lhs, const T& rhs) { return lhs -= rhs; }
+        /** @brief Subtraction operator, counted as an addition */
+        friend Counted operator-(const T& lhs, const Counted& rhs) { return Counted(lhs) -= rhs; }
+        /** @brief Multiplication operator, counted as a multiplication */
+        friend Counted operator*(Counted lhs, const Counted& rhs) { return lhs *= rhs; }
+        /** @brief Multiplication operator, counted as a multiplication */
+        friend Counted operator*(Counted lhs, const T& rhs) { return lhs *= rhs; }
+        /** @brief Multiplication operator, counted as a multiplication */
+        friend Counted operator*(const T& lhs, const Counted& rhs) { return Counted(lhs) *= rhs; }
+        /** @brief Integer multiplication operator, counted as a multiplication */
+        friend Counted operator*(Counted lhs, const UnderlyingType& rhs) { return lhs *= rhs; }
+        /** @brief Integer multiplication operator, counted as a multiplication */
+        friend Counted operator*(UnderlyingType lhs, Counted rhs) { return rhs *= lhs; }
+        /** @brief Division operator, counted as a division */
+        friend Counted operator/(Counted lhs, const Counted& rhs) { return lhs /= rhs; }
+        /** @brief Division operator, counted as a division */
+        friend Counted operator/(Counted lhs, const T& rhs) { return lhs /= rhs; }
+        /** @brief Division operator, counted as a division */
+        friend Counted operator/(const T& lhs, const Counted& rhs) { return Counted(lhs) /= rhs; }
+        /** @brief Integer division operator, counted as a division */
+        friend Counted operator/(Counted lhs, const UnderlyingType& rhs) { return lhs /= rhs; }
+        /** @brief Multiplication operator by a reciprocal, counted as a multiplication */
+        friend Counted operator*(const Counted& lhs, const typename T::Reciprocal& rhs) {
+            CountingScope::count(Operation::MULTIPLICATION);
+            return (const T&)lhs * rhs;
+        }
+        /** @brief Multiplication operator by a reciprocal, counted as a multiplication */
+        friend Counted operator*(const typename T::Reciprocal& lhs, const Counted& rhs) { return rhs * lhs; }
+
+        /**
+         * @brief See Fixed::Accumulator, which counts each product added to
+         * it as a multiplication and each value as an addition
+         */
+        class Accumulator : public T::Accumulator {
+        public:
+            /** @brief Creates an Accumulator with a sum of zero */
+            constexpr Accumulator() {}
+            /** @brief Multiply-accumulate, counted as a multiplication */
+            Accumulator& mac(const T& lhs, const T& rhs) {
+                CountingScope::count(Operation::MULTIPLICATION);
+                T::Accumulator::mac(lhs, rhs);
+                return *this;
+            }
+            /** @brief Compound assignment addition operator, counted as an addition */
+            Accumulator& operator+=(const T& value) {
+                CountingScope::count(Operation::ADDITION);
+                T::Accumulator::operator+=(value);
+                return *this;
+            }
+            /** @brief Compound assignment subtraction operator, counted as an addition */
+            Accumulator& operator-=(const T& value) {
+                CountingScope::count(Operation::ADDITION);
+                T::Accumulator::operator-=(value);
+                return *this;
+            }
+            /** @returns The sum, see Fixed::Accumulator::result() */
+            constexpr Counted result() const {
+                return T::Accumulator::result();
+            }
+        };
+    };
+#else
+    // counting is compiled out, so these are no-ops and Counted<T> is T itself
+    class CountingScope {
+    public:
+        constexpr CountingScope() {}
+        CountingScope(const CountingScope&) = delete;
+        CountingScope& operator=(const CountingScope&) = delete;
+        constexpr OperationCounts counts() const { return {}; }
+        constexpr uint32_t estimated_cycles(const CycleTable& = CycleTable::R3000()) const { return 0; }
+        constexpr bool report(char* buffer, size_t buffer_size, const CycleTable& table = CycleTable::R3000()) const {
+            return OperationCounts().report(buffer, buffer_size, table);
+        }
+        static constexpr void count(CountedOperation) {}
+    };
+
+    template <typename T>
+    using Counted = T;
+#endif
+
+    /**
+     * @brief PSXFixed which counts the operations done with it when
+     * #UNMOVING_COUNT_OPERATIONS is `1`
+     */
+    using CountedPSXFixed = Counted<PSXFixed>;
+}
+
+#endif // include guard
@@ -0,0 +1,281 @@
+/**
+ * @file
+ * @brief This file forms part of Unmoving
+ * @details Provides exponential, logarithm and power functions for PSXFixed,
+ * for things like fog curves, audio envelopes and easing. They are calculated
+ * from small tables, which are generated at compile-time, and short
+ * fixed-point polynomials, using only integer arithmetic at run-time. They
+ * give the same results on the PlayStation as on any other platform.
+ *
+ * The maximum errors of the results are:
+ *
+ * | Function | Maximum error                                                     |
+ * | -------- | ----------------------------------------------------------------- |
+ * | exp2()   | 0.5 steps + `2**-28` times the result                             |
+ * | exp()    | 0.5 steps + `2**-27` times the result                             |
+ * | log2()   | 0.5 steps + `2**-25`                                              |
+ * | log()    | 0.5 steps + `2**-25`                                              |
+ * | pow()    | 0.5 steps + `2**-25` times the result and `max(1, abs(exponent))` |
+ *
+ * where a step is PSXFixed::PRECISION. So, the error of each result is
+ * almost all from rounding it to the nearest PSXFixed value.
+ *
+ * @author Joshua Saxby <joshua.a.saxby@gmail.com>
+ * @date September 2021
+ *
+ * @copyright Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_UNMOVING_EXPONENTIAL_HPP
+#define COM_SAXBOPHONE_UNMOVING_EXPONENTIAL_HPP
+
+#include "PSXFixed.hpp"
+
+namespace unmoving {
+    namespace detail {
+        inline constexpr double LN_2 = 0.693147180559945309417;
+
+        // e**x, for x in the range [0..1], by its Taylor series
+        constexpr double exponential_series(double x) {
+            double term = 1.0;
+            double sum = 1.0;
+            for (int i = 1; i < 25; i++) {
+                term *= x / i;
+                sum += term;
+            }
+            return sum;
+        }
+
+        // ln(x), for x in the range [1..2], by the series of 2 * atanh((x - 1) / (x + 1))
+        constexpr double logarithm_series(double x) {
+            double ratio = (x - 1.0) / (x + 1.0);
+            double power = ratio;
+            double sum = 0.0;
+            for (int i = 0; i < 30; i++) {
+                sum += power / (2 * i + 1);
+                power *= ratio * ratio;
+            }
+            return 2.0 * sum;
+        }
+
+        // number of intervals the tables divide [1..2) into
+        inline constexpr uint32_t EXPONENTIAL_INTERVALS = 16;
+
+        struct ExponentialTable {
+            // 2**(i / 16), as 2.30 fractions
+            uint32_t powers[EXPONENTIAL_INTERVALS];
+            // log2(1 + i / 16), as 0.32 fractions
+            uint32_t logarithms[EXPONENTIAL_INTERVALS];
+            // 1 / (1 + i / 16), as 1.31 fractions
+            uint32_t reciprocals[EXPONENTIAL_INTERVALS];
+        };
+
+        constexpr ExponentialTable make_exponential_table() {
+            ExponentialTable table = {};
+            for (uint32_t i = 0; i < EXPONENTIAL_INTERVALS; i++) {
+                double offset = (double)i / EXPONENTIAL_INTERVALS;
+                table.powers[i] = (uint32_t)(exponential_series(offset * LN_2) * 1073741824.0 + 0.5);
+                table.logarithms[i] = (uint32_t)(logarithm_series(1.0 + offset) / LN_2 * 4294967296.0 + 0.5);
+                table.reciprocals[i] = (uint32_t)(2147483648.0 / (1.0 + offset) + 0.5);
+            }
+            return table;
+        }
+
+        inline constexpr ExponentialTable EXPONENTIAL_TABLE = make_exponential_table();
+
+        // coefficients of the Taylor series of 2**x - 1, ln(2)**n / n!, as 0.32 fractions
+        inline constexpr uint32_t EXP2_COEFFICIENTS[4] = {
+            (uint32_t)(LN_2 * 4294967296.0 + 0.5),
+            (uint32_t)(LN_2 * LN_2 / 2.0 * 4294967296.0 + 0.5),
+            (uint32_t)(LN_2 * LN_2 * LN_2 / 6.0 * 4294967296.0 + 0.5),
+            (uint32_t)(LN_2 * LN_2 * LN_2 * LN_2 / 24.0 * 4294967296.0 + 0.5),
+        };
+        // 1 / ln(2) == log2(e), as a 1.31 fraction
+        inline constexpr uint32_t LOG2_E = (uint32_t)(2147483648.0 / LN_2 + 0.5);
+        // ln(2), as a 0.32 fraction
+        inline constexpr uint32_t LN_2_FRACTION = (uint32_t)(LN_2 * 4294967296.0 + 0.5);
+
+        /*
+         * 2**exponent as a raw PSXFixed value, rounded to nearest, saturated to
+         * PSXFixed::MAX() if too large, where the magnitude of exponent is
+         * whole + fraction / 2**32
+         */
+        constexpr PSXFixed::UnderlyingType power_of_two(uint32_t whole, uint32_t fraction, bool negative) {
+            // everything this far from zero is out of range one way or the other
+            if (whole >= 64) {
+                return negative ? 0 : (PSXFixed::UnderlyingType)PSXFixed::MAX();
+            }
+            int32_t exponent = (int32_t)whole;
+            if (negative) {
+                // 2**-(whole + fraction) == 2**(-(whole + 1) + (1 - fraction))
+                exponent = -exponent;
+                if (fraction != 0) {
+                    exponent--;
+                    fraction = 0u - fraction;
+                }
+            }
+            // 2**fraction == 2**(i / 16) * 2**remainder, where remainder < 1/16 so its series converges quickly
+            uint32_t index = fraction >> 28;
+            uint32_t remainder = fraction & 0x0FFFFFFF;
+            uint32_t series = EXP2_COEFFICIENTS[3];
+            series = EXP2_COEFFICIENTS[2] + multiply_shift_u32(series, remainder, 32);
+            series = EXP2_COEFFICIENTS[1] + multiply_shift_u32(series, remainder, 32);
+            series = EXP2_COEFFICIENTS[0] + multiply_shift_u32(series, remainder, 32);
+            series = multiply_shift_u32(series, remainder, 32);
+            uint32_t power = EXPONENTIAL_TABLE.powers[index];
+            // as a 2.30 fraction, in the range [1..2)
+            uint32_t mantissa = power + multiply_shift_u32(power, series, 32);
+            // mantissa * 2**exponent, from 2.30 to 20.12
+            int32_t shift = 18 - exponent;
+            if (shift < 0) {
+                return (PSXFixed::UnderlyingType)PSXFixed::MAX();
+            }
+            if (shift == 0) {
+                return (PSXFixed::UnderlyingType)mantissa;
+            }
+            if (shift > 32) {
+                return 0;
+            }
+            return (PSXFixed::UnderlyingType)(((mantissa >> (shift - 1)) + 1) >> 1);
+        }
+
+        /*
+         * log2(value) as a signed 6.26 fixed-point number
+         * NOTE: value must be positive
+         */
+        constexpr int32_t logarithm_of_two(uint32_t value) {
+            size_t leading_zeros = count_leading_zeros(value);
+            // normalised as a 1.31 fraction, in the range [1..2)
+            uint32_t normalised = value << leading_zeros;
+            uint32_t index = (normalised >> 27) & 0xF;
+            // log2(normalised) == log2(1 + i / 16) + log2(1 + t), where t < 1/16 so its series converges quickly
+            uint32_t base = 0x80000000u | (index << 27);
+            uint32_t t = multiply_shift_u32(normalised - base, EXPONENTIAL_TABLE.reciprocals[index], 30);
+            // ln(1 + t) == t - t**2 * (1/2 - t * (1/3 - t * (1/4 - t / 5)))
+            uint32_t series = 0x40000000u - t / 5;
+            series = 0x55555555u - multiply_shift_u32(t, series, 32);
+            series = 0x80000000u - multiply_shift_u32(t, series, 32);
+            uint32_t natural = t - multiply_shift_u32(t, multiply_shift_u32(t, series, 32), 32);
+            uint32_t fraction = EXPONENTIAL_TABLE.logarithms[index] + multiply_shift_u32(natural, LOG2_E, 31);
+            // the log2 of the raw value, less the fraction bits
+            int32_t whole = 31 - (int32_t)leading_zeros - (int32_t)PSXFixed::FRACTION_BITS;
+            return (int32_t)((uint32_t)whole << 26) + (int32_t)((fraction >> 6) + ((fraction >> 5) & 1));
+        }
+
+        // a signed 6.26 fixed-point number, rounded to the nearest raw PSXFixed value
+        constexpr PSXFixed::UnderlyingType round_logarithm(int32_t value) {
+            // rounded on the magnitude so that the results are symmetric
+            uint32_t rounded = ((magnitude(value) >> 13) + 1) >> 1;
+            return (PSXFixed::UnderlyingType)(value < 0 ? 0u - rounded : rounded);
+        }
+    }
+
+    /**
+     * @returns 2 raised to the power of `exponent`, rounded to the nearest
+     * PSXFixed value
+     * @details Calculated from a table of 16 powers of 2 between 1 and 2
+     * and a quartic polynomial.
+     * @note Saturates to PSXFixed::MAX() if the result is out of range.
+     * @b Usage:
+     * @code
+     * PSXFixed volume = unmoving::exp2(-time / half_life);
+     * @endcode
+     */
+    constexpr PSXFixed exp2(PSXFixed exponent) {
+        uint32_t magnitude = detail::magnitude((PSXFixed::UnderlyingType)exponent);
+        return PSXFixed(detail::power_of_two(
+            magnitude >> PSXFixed::FRACTION_BITS,
+            magnitude << (32 - PSXFixed::FRACTION_BITS),
+            exponent < 0
+        ));
+    }
+
+    /**
+     * @returns e raised to the power of `exponent`, rounded to the nearest
+     * PSXFixed value
+     * @details Calculated as `exp2(exponent * log2(e))`, with the product
+     * kept to 32 fraction bits.
+     * @note Saturates to PSXFixed::MAX() if the result is out of range.
+     */
+    constexpr PSXFixed exp(PSXFixed exponent) {
+        // 20.12 times 1.31 is 43 fraction bits
+        detail::DoubleWord product = detail::multiply_u32(
+            detail::magnitude((PSXFixed::UnderlyingType)exponent),
+            detail::LOG2_E
+        );
+        return PSXFixed(detail::power_of_two(
+            product.hi >> 11,
+            detail::shift_right(product, 11),
+            exponent < 0
+        ));
+    }
+
+    /**
+     * @returns The base-2 logarithm of `value`, rounded to the nearest
+     * PSXFixed value
+     * @details Calculated from a table of 16 logarithms between 1 and 2 and a
+     * polynomial.
+     * @warning The logarithm of zero or a negative value is undefined.
+     * Returns PSXFixed::MIN().
+     */
+    constexpr PSXFixed log2(PSXFixed value) {
+        if (value <= 0) { return PSXFixed::MIN(); }
+        return PSXFixed(detail::round_logarithm(detail::logarithm_of_two((uint32_t)(PSXFixed::UnderlyingType)value)));
+    }
+
+    /**
+     * @returns The natural logarithm of `value`, rounded to the nearest
+     * PSXFixed value
+     * @details Calculated as `log2(value) * ln(2)`, with the base-2 logarithm
+     * kept to 26 fraction bits.
+     * @warning The logarithm of zero or a negative value is undefined.
+     * Returns PSXFixed::MIN().
+     */
+    constexpr PSXFixed log(PSXFixed value) {
+        if (value <= 0) { return PSXFixed::MIN(); }
+        int32_t logarithm = detail::logarithm_of_two((uint32_t)(PSXFixed::UnderlyingType)value);
+        // 6.26 times 0.32 is 58 fraction bits, which are rounded to 6.26 again
+        uint32_t natural = detail::multiply_shift_u32(detail::magnitude(logarithm), detail::LN_2_FRACTION, 31);
+        natural = (natural >> 1) + (natural & 1);
+        return PSXFixed(detail::round_logarithm(logarithm < 0 ? -(int32_t)natural : (int32_t)natural));
+    }
+
+    /**
+     * @returns `base` raised to the power of `exponent`, rounded to the
+     * nearest PSXFixed value
+     * @details Calculated as `exp2(exponent * log2(base))`, with the
+     * logarithm kept to 26 fraction bits and the product to 32.
+     * @note Saturates to PSXFixed::MAX() if the result is out of range.
+     * @warning Only positive bases are supported. Returns zero for a base
+     * which is zero or negative.
+     * @b Usage:
+     * @code
+     * PSXFixed eased = unmoving::pow(t, 2.5_fx);
+     * @endcode
+     */
+    constexpr PSXFixed pow(PSXFixed base, PSXFixed exponent) {
+        if (base <= 0) { return PSXFixed(); }
+        int32_t logarithm = detail::logarithm_of_two((uint32_t)(PSXFixed::UnderlyingType)base);
+        // 20.12 times 6.26 is 38 fraction bits
+        detail::DoubleWord product = detail::multiply_u32(
+            detail::magnitude((PSXFixed::UnderlyingType)exponent),
+            detail::magnitude(logarithm)
+        );
+        // the whole part would be 64 or more, which power_of_two() saturates anyway
+        if (product.hi >= ((uint32_t)64 << 6)) {
+            return PSXFixed(detail::power_of_two(64, 0, (exponent < 0) != (logarithm < 0)));
+        }
+        return PSXFixed(detail::power_of_two(
+            product.hi >> 6,
+            detail::shift_right(product, 6),
+            (exponent < 0) != (logarithm < 0)
+        ));
+    }
+}
+
+#endif // include guard
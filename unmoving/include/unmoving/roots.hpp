@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @brief This file forms part of Unmoving
+ * @details Provides square root and reciprocal square root functions for
+ * PSXFixed, for calculating the lengths of vectors and normalising them. They
+ * are calculated a digit at a time with only 32-bit integer arithmetic, so
+ * are exact (correctly rounded) and give the same results on the PlayStation
+ * as on any other platform.
+ *
+ * @author Joshua Saxby <joshua.a.saxby@gmail.com>
+ * @date September 2021
+ *
+ * @copyright Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_UNMOVING_ROOTS_HPP
+#define COM_SAXBOPHONE_UNMOVING_ROOTS_HPP
+
+#include "PSXFixed.hpp"
+
+namespace unmoving {
+    namespace detail {
+        /*
+         * floor(sqrt(radicand)), worked out two bits of the radicand at a time
+         * like long division, using only 32-bit arithmetic
+         * NOTE: radicand must be less than 2**58, so the remainder fits in 32 bits
+         */
+        constexpr uint32_t square_root(DoubleWord radicand) {
+            // skip over the pairs of leading zero bits, which don't change anything
+            size_t bits = radicand.hi != 0 ? 64 - count_leading_zeros(radicand.hi) : 32 - count_leading_zeros(radicand.lo);
+            uint32_t root = 0;
+            uint32_t remainder = 0;
+            for (size_t pair = (bits + 1) / 2; pair-- > 0; ) {
+                uint32_t next_bits = pair >= 16 ? radicand.hi >> (2 * pair - 32) : radicand.lo >> (2 * pair);
+                remainder = (remainder << 2) | (next_bits & 3);
+                // the next bit of the root is set if (2 * root + 1)**2 still fits under the radicand so far
+                uint32_t trial = (root << 2) | 1;
+                root <<= 1;
+                if (remainder >= trial) {
+                    remainder -= trial;
+                    root |= 1;
+                }
+            }
+            return root;
+        }
+
+        /*
+         * round(sqrt(radicand / 4)), where radicand is 4 times the exact value
+         * to take the root of, rounded down
+         * NOTE: this works because floor((sqrt(x) + 1) / 2) == floor((floor(sqrt(x)) + 1) / 2)
+         */
+        constexpr uint32_t rounded_square_root(DoubleWord radicand) {
+            return (square_root(radicand) + 1) >> 1;
+        }
+    }
+
+    /**
+     * @returns The square root of `value`, rounded to the nearest PSXFixed value
+     * @details Calculated a bit at a time, so takes about as long as a
+     * division. Only 32-bit integer arithmetic is used.
+     * @warning The square root of a negative value is undefined. Returns zero.
+     * @b Usage:
+     * @code
+     * PSXFixed length = unmoving::sqrt(x * x + y * y);
+     * @endcode
+     */
+    constexpr PSXFixed sqrt(PSXFixed value) {
+        PSXFixed::UnderlyingType raw = value;
+        if (raw <= 0) { return PSXFixed(); }
+        // sqrt(raw / SCALE) * SCALE == sqrt(raw * SCALE), which needs up to 44 bits (46 bits when quadrupled)
+        constexpr size_t SHIFT = PSXFixed::FRACTION_BITS + 2;
+        detail::DoubleWord radicand = {(uint32_t)raw >> (32 - SHIFT), (uint32_t)raw << SHIFT};
+        return PSXFixed((PSXFixed::UnderlyingType)detail::rounded_square_root(radicand));
+    }
+
+    /**
+     * @returns The reciprocal of the square root of `value` (that is,
+     * `1 / sqrt(value)`), rounded to the nearest PSXFixed value
+     * @details Useful for normalising vectors, which then only needs
+     * multiplications by the result rather than divisions. Only 32-bit
+     * integer arithmetic is used.
+     * @warning The reciprocal square root of zero or a negative value is
+     * undefined. Returns PSXFixed::MAX().
+     * @b Usage:
+     * @code
+     * PSXFixed scale = unmoving::rsqrt(x * x + y * y);
+     * x *= scale;
+     * y *= scale;
+     * @endcode
+     */
+    constexpr PSXFixed rsqrt(PSXFixed value) {
+        PSXFixed::UnderlyingType raw = value;
+        if (raw <= 0) { return PSXFixed::MAX(); }
+        // SCALE / sqrt(raw / SCALE) == sqrt(SCALE**3 / raw), quadrupled and rounded down
+        constexpr size_t SHIFT = 3 * PSXFixed::FRACTION_BITS + 2;
+        uint32_t divisor = (uint32_t)raw;
+        uint32_t remainder = 0;
+        uint32_t hi = ((uint32_t)1 << (SHIFT - 32)) / divisor;
+        uint32_t lo = detail::divide_u64_u32({((uint32_t)1 << (SHIFT - 32)) % divisor, 0}, divisor, remainder);
+        return PSXFixed((PSXFixed::UnderlyingType)detail::rounded_square_root({hi, lo}));
+    }
+}
+
+#endif // include guard
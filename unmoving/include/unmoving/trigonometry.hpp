@@ -0,0 +1,381 @@
+/**
+ * @file
+ * @brief This file forms part of Unmoving
+ * @details Provides trigonometric functions for PSXFixed, with angles in the
+ * same units as the `rsin()` and `rcos()` functions of the PlayStation SDK
+ * (4096 per turn). Sine and cosine are calculated from a small table of the
+ * sine of a quarter turn, and arctangent and conversions to and from polar
+ * form with CORDIC. The tables are generated at compile-time, and only
+ * integer arithmetic is used at run-time, so they give the same results on
+ * the PlayStation as on any other platform, making it possible to run the
+ * same simulation code off the console.
+ *
+ * @author Joshua Saxby <joshua.a.saxby@gmail.com>
+ * @date September 2021
+ *
+ * @copyright Copyright Joshua Saxby <joshua.a.saxby@gmail.com> 2021
+ *
+ * @copyright
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COM_SAXBOPHONE_UNMOVING_TRIGONOMETRY_HPP
+#define COM_SAXBOPHONE_UNMOVING_TRIGONOMETRY_HPP
+
+#include "PSXFixed.hpp"
+
+/**
+ * @def UNMOVING_SINE_TABLE_BITS
+ * @brief Log2 of the number of intervals the sine table divides a quarter
+ * turn into
+ * @details The table holds `2**UNMOVING_SINE_TABLE_BITS + 1` 16-bit entries.
+ * Angles which fall between two entries are linearly interpolated between
+ * them. A larger table is more accurate, but takes more memory (and cache):
+ *
+ * | Bits | Table size | Maximum error |
+ * | ---- | ---------- | ------------- |
+ * | 4    | 34 bytes   | 5.4 steps     |
+ * | 6    | 130 bytes  | 0.71 steps    |
+ * | 8    | 514 bytes  | 0.61 steps    |
+ * | 10   | 2050 bytes | 0.57 steps    |
+ *
+ * where a step is PSXFixed::PRECISION. At 10 bits, there is an entry for
+ * every angle and no interpolation is done.
+ * @note Must be in the range `[2..10]`. Defaults to `8`. Define it before
+ * including this header to override.
+ */
+#ifndef UNMOVING_SINE_TABLE_BITS
+#define UNMOVING_SINE_TABLE_BITS 8
+#endif
+
+namespace unmoving {
+    namespace detail {
+        static_assert(
+            2 <= UNMOVING_SINE_TABLE_BITS and UNMOVING_SINE_TABLE_BITS <= 10,
+            "UNMOVING_SINE_TABLE_BITS must be in the range [2..10]"
+        );
+
+        // number of angle units in a quarter turn
+        inline constexpr uint32_t QUARTER_TURN = 1024;
+
+        // number of low bits of an angle within a quarter turn to interpolate between table entries by
+        inline constexpr size_t SINE_INTERPOLATION_BITS = 10 - UNMOVING_SINE_TABLE_BITS;
+
+        // sine of each interval of a quarter turn, as 1.15 fractions (so the last one is 32768)
+        struct SineTable {
+            uint16_t values[((size_t)1 << UNMOVING_SINE_TABLE_BITS) + 1];
+        };
+
+        // sine of x in radians, for x in the range [0..pi/2], by its Taylor series
+        constexpr double sine_series(double x) {
+            double term = x;
+            double sum = x;
+            // the terms shrink so quickly here that this is exact to double precision
+            for (int i = 1; i < 12; i++) {
+                term *= -x * x / ((2 * i) * (2 * i + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr SineTable make_sine_table() {
+            constexpr double HALF_PI = 1.57079632679489661923;
+            constexpr uint32_t INTERVALS = (uint32_t)1 << UNMOVING_SINE_TABLE_BITS;
+            SineTable table = {};
+            for (uint32_t i = 0; i <= INTERVALS; i++) {
+                table.values[i] = (uint16_t)(sine_series(HALF_PI * i / INTERVALS) * 32768.0 + 0.5);
+            }
+            return table;
+        }
+
+        inline constexpr SineTable SINE_TABLE = make_sine_table();
+
+        // sine of angle (in 4096ths of a turn, wrapped to one turn), as a raw PSXFixed value
+        constexpr PSXFixed::UnderlyingType sine(uint32_t angle) {
+            uint32_t quadrant = (angle / QUARTER_TURN) % 4;
+            uint32_t offset = angle % QUARTER_TURN;
+            // the second and fourth quadrants are mirror images of the first and third
+            if (quadrant % 2 == 1) {
+                offset = QUARTER_TURN - offset;
+            }
+            uint32_t index = offset >> SINE_INTERPOLATION_BITS;
+            uint32_t value = SINE_TABLE.values[index];
+            if constexpr (SINE_INTERPOLATION_BITS > 0) {
+                uint32_t fraction = offset & (((uint32_t)1 << SINE_INTERPOLATION_BITS) - 1);
+                if (fraction != 0) {
+                    // sine only increases over the first quadrant, so the difference can't be negative
+                    uint32_t difference = SINE_TABLE.values[index + 1] - value;
+                    value += (difference * fraction + ((uint32_t)1 << (SINE_INTERPOLATION_BITS - 1)))
+                        >> SINE_INTERPOLATION_BITS;
+                }
+            }
+            // round from 1.15 to 20.12, before the sign so that sine is symmetric about zero
+            uint32_t result = (value + 4) >> 3;
+            // the third and fourth quadrants are the negatives of the first and second
+            return (PSXFixed::UnderlyingType)(quadrant >= 2 ? 0u - result : result);
+        }
+
+        // number of iterations of CORDIC, each of which gives about one more bit of accuracy
+        inline constexpr size_t CORDIC_ITERATIONS = 30;
+
+        // angles of each rotation CORDIC does, atan(2**-i), as 2**32ths of a turn
+        struct CordicTable {
+            uint32_t angles[CORDIC_ITERATIONS];
+            // 1 / the product of the lengths of each rotation, sqrt(1 + 2**-2i), as a 0.32 fraction
+            uint32_t inverse_gain;
+        };
+
+        // atan(x) in radians, for x in the range [0..1/2], by its Taylor series
+        constexpr double arctangent_series(double x) {
+            double power = x;
+            double sum = x;
+            for (int i = 1; i < 30; i++) {
+                power *= -x * x;
+                sum += power / (2 * i + 1);
+            }
+            return sum;
+        }
+
+        constexpr CordicTable make_cordic_table() {
+            constexpr double TAU = 6.28318530717958647692;
+            CordicTable table = {};
+            // atan(1) is exactly an eighth of a turn
+            table.angles[0] = (uint32_t)1 << 29;
+            double scale = 1.0;
+            for (size_t i = 1; i < CORDIC_ITERATIONS; i++) {
+                double tangent = 1.0 / (double)((uint32_t)1 << i);
+                table.angles[i] = (uint32_t)(arctangent_series(tangent) / TAU * 4294967296.0 + 0.5);
+                scale *= 1.0 + tangent * tangent;
+            }
+            // including the first rotation, which is by sqrt(2)
+            double squared_gain = 2.0 * scale;
+            // so the inverse gain is the reciprocal of its square root, found by Newton's method
+            double inverse = 0.5;
+            for (int i = 0; i < 8; i++) {
+                inverse *= 1.5 - 0.5 * squared_gain * inverse * inverse;
+            }
+            table.inverse_gain = (uint32_t)(inverse * 4294967296.0 + 0.5);
+            return table;
+        }
+
+        inline constexpr CordicTable CORDIC_TABLE = make_cordic_table();
+
+        // an angle as 2**32ths of a turn, rounded to the nearest 4096th of a turn in the range (-2048..2048]
+        constexpr PSXFixed::UnderlyingType round_angle(uint32_t angle) {
+            uint32_t rounded = ((angle >> 19) + 1) >> 1;
+            // 4096 is the same as zero
+            rounded %= 4096;
+            return (PSXFixed::UnderlyingType)(rounded > 2048 ? rounded - 4096 : rounded);
+        }
+
+        // shift needed to bring the highest set bit of value to bit 29, negative if it's above it
+        constexpr int normalising_shift(uint32_t value) {
+            return (int)count_leading_zeros(value) - 2;
+        }
+
+        // value * 2**-shift, rounded to nearest
+        constexpr uint32_t denormalise(uint32_t value, int shift) {
+            if (shift > 0) {
+                return (value >> shift) + ((value >> (shift - 1)) & 1u);
+            }
+            return value << -shift;
+        }
+
+        // a vector in polar form, as found by cordic_vectoring()
+        struct Polar {
+            // angle of the vector from the positive x-axis, as 2**32ths of a turn
+            uint32_t angle;
+            // length of the vector, times 2**shift (not yet divided by the gain)
+            uint32_t length;
+            int shift;
+        };
+
+        /*
+         * rotates (x, y) onto the positive x-axis with CORDIC, which finds its
+         * angle from the rotations made and its length from where it ends up
+         */
+        constexpr Polar cordic_vectoring(int32_t x, int32_t y) {
+            // a zero vector has no angle, but call it zero
+            if (x == 0 and y == 0) {
+                return {0, 0, 0};
+            }
+            uint32_t x_magnitude = magnitude(x);
+            uint32_t y_magnitude = magnitude(y);
+            // scale the vector up (or down) so that its larger component has its top bit at bit 29
+            int shift = normalising_shift(x_magnitude | y_magnitude);
+            uint32_t rotated_x = shift >= 0 ? x_magnitude << shift : x_magnitude >> -shift;
+            // the length grows by up to 2.33 times, but as rotated_x only grows, it still fits unsigned
+            int32_t rotated_y = (int32_t)(shift >= 0 ? y_magnitude << shift : y_magnitude >> -shift);
+            // the vector is folded into the first quadrant, so only the angle within it is needed
+            uint32_t angle = 0;
+            for (size_t i = 0; i < CORDIC_ITERATIONS; i++) {
+                uint32_t x_step = rotated_x >> i;
+                int32_t y_step = rotated_y >> i;
+                // rotate clockwise if above the x-axis and anticlockwise if below
+                if (rotated_y >= 0) {
+                    rotated_x += (uint32_t)y_step;
+                    rotated_y -= (int32_t)x_step;
+                    angle += CORDIC_TABLE.angles[i];
+                } else {
+                    rotated_x -= (uint32_t)y_step;
+                    rotated_y += (int32_t)x_step;
+                    angle -= CORDIC_TABLE.angles[i];
+                }
+            }
+            // unfold the angle from the first quadrant
+            if (x < 0) {
+                angle = ((uint32_t)1 << 31) - angle;
+            }
+            if (y < 0) {
+                angle = 0u - angle;
+            }
+            return {angle, rotated_x, shift};
+        }
+
+        /*
+         * rotates (length, 0) by angle (2**32ths of a turn) with CORDIC, giving
+         * the components of the vector with that length and angle
+         */
+        constexpr void cordic_rotation(uint32_t angle, int32_t length, int32_t& x, int32_t& y) {
+            uint32_t length_magnitude = magnitude(length);
+            // a negative length points the other way
+            if (length < 0) {
+                angle += (uint32_t)1 << 31;
+            }
+            // CORDIC only converges for angles within a quarter turn, so rotate by a half turn if further
+            bool flip = angle - ((uint32_t)1 << 30) < ((uint32_t)1 << 31);
+            if (flip) {
+                angle += (uint32_t)1 << 31;
+            }
+            int shift = normalising_shift(length_magnitude);
+            uint32_t normalised = shift >= 0 ? length_magnitude << shift : length_magnitude >> -shift;
+            // divide out the gain up-front, so that the rotations leave the vector the right length
+            int32_t rotated_x = (int32_t)multiply_shift_u32(normalised, CORDIC_TABLE.inverse_gain, 32);
+            int32_t rotated_y = 0;
+            int32_t remaining = (int32_t)angle;
+            for (size_t i = 0; i < CORDIC_ITERATIONS; i++) {
+                int32_t x_step = rotated_x >> i;
+                int32_t y_step = rotated_y >> i;
+                // rotate towards the remaining angle
+                if (remaining >= 0) {
+                    rotated_x -= y_step;
+                    rotated_y += x_step;
+                    remaining -= (int32_t)CORDIC_TABLE.angles[i];
+                } else {
+                    rotated_x += y_step;
+                    rotated_y -= x_step;
+                    remaining += (int32_t)CORDIC_TABLE.angles[i];
+                }
+            }
+            // round back to the original scale, on the magnitudes so that the results are symmetric
+            uint32_t x_result = denormalise(magnitude(rotated_x), shift);
+            uint32_t y_result = denormalise(magnitude(rotated_y), shift);
+            x = (int32_t)((rotated_x < 0) != flip ? 0u - x_result : x_result);
+            y = (int32_t)((rotated_y < 0) != flip ? 0u - y_result : y_result);
+        }
+    }
+
+    /**
+     * @returns The sine of `angle`
+     * @param angle in turns, so that the raw value of angle is in the same
+     * units as the angles passed to `rsin()` (4096 per turn). Angles outside
+     * of one turn are wrapped around.
+     * @details Looked up from a table of the sine of a quarter turn, which is
+     * interpolated between entries. The result is within one step
+     * (PSXFixed::PRECISION) of the exact sine with the default table size.
+     * @see UNMOVING_SINE_TABLE_BITS
+     * @note The results are symmetric, so that `sin(-x) == -sin(x)` and
+     * `sin(0.5_fx - x) == sin(x)`, and exact at multiples of a quarter turn.
+     * @b Usage:
+     * @code
+     * PSXFixed y = unmoving::sin(0.25_fx); // sine of a quarter turn, 1.0_fx
+     * PSXFixed x = unmoving::sin(PSXFixed(512)); // sine of an eighth of a turn
+     * @endcode
+     */
+    constexpr PSXFixed sin(PSXFixed angle) {
+        return PSXFixed(detail::sine((uint32_t)(PSXFixed::UnderlyingType)angle));
+    }
+
+    /**
+     * @returns The cosine of `angle`
+     * @param angle in turns, so that the raw value of angle is in the same
+     * units as the angles passed to `rcos()` (4096 per turn). Angles outside
+     * of one turn are wrapped around.
+     * @details Calculated as the sine of the angle a quarter turn further on,
+     * so has the same accuracy as unmoving::sin().
+     */
+    constexpr PSXFixed cos(PSXFixed angle) {
+        return PSXFixed(detail::sine((uint32_t)(PSXFixed::UnderlyingType)angle + detail::QUARTER_TURN));
+    }
+
+    /**
+     * @returns The angle of the vector `(x, y)` from the positive x-axis, in
+     * turns in the range `(-0.5..0.5]`, so that its raw value is in the same
+     * units as the angles passed to `rsin()` and `rcos()` (4096 per turn)
+     * @details Calculated with CORDIC, which uses only shifts and additions.
+     * The result is the exact angle rounded to the nearest 4096th of a turn,
+     * give or take a millionth of a turn for angles very close to halfway
+     * between two.
+     * @note The angle of the zero vector is zero.
+     * @b Usage:
+     * @code
+     * PSXFixed heading = unmoving::atan2(target_y - y, target_x - x);
+     * @endcode
+     */
+    constexpr PSXFixed atan2(PSXFixed y, PSXFixed x) {
+        return PSXFixed(detail::round_angle(detail::cordic_vectoring(x, y).angle));
+    }
+
+    /**
+     * @brief Converts the vector `(x, y)` into polar form
+     * @param x,y components of the vector
+     * @param[out] angle set to the angle of the vector, as returned by
+     * unmoving::atan2()
+     * @param[out] length set to the length of the vector, rounded to the
+     * nearest PSXFixed value. Saturates to PSXFixed::MAX() if the length is
+     * out of range.
+     * @details Calculated with CORDIC, which gives the length of the vector
+     * as a by-product of finding its angle, so this is cheaper than calling
+     * unmoving::atan2() and unmoving::sqrt() separately. The error in the
+     * length is at most half a step plus `2**-25` times the length, so is
+     * less than one step for lengths up to `4096.0_fx`.
+     */
+    constexpr void to_polar(PSXFixed x, PSXFixed y, PSXFixed& angle, PSXFixed& length) {
+        detail::Polar polar = detail::cordic_vectoring(x, y);
+        angle = PSXFixed(detail::round_angle(polar.angle));
+        // the length needs the gain of the rotations dividing out of it
+        uint32_t scaled = detail::multiply_shift_u32(polar.length, detail::CORDIC_TABLE.inverse_gain, 32);
+        // scaling back down can't overflow, only back up can
+        if (polar.shift < 0 and scaled > ((uint32_t)PSXFixed::MAX() >> -polar.shift)) {
+            length = PSXFixed::MAX();
+        } else {
+            length = PSXFixed((PSXFixed::UnderlyingType)detail::denormalise(scaled, polar.shift));
+        }
+    }
+
+    /**
+     * @brief Converts a vector from polar form into its components
+     * @param angle of the vector, in the same units as unmoving::sin()
+     * @param length of the vector. A negative length points the opposite way.
+     * @param[out] x,y set to the components of the vector, rounded to the
+     * nearest PSXFixed value. These wrap around if they are out of range.
+     * @details Calculated with CORDIC, which only uses shifts and additions.
+     * The error in each component is at most half a step plus `2**-25`
+     * times the length, so is less than one step for lengths up to
+     * `4096.0_fx`.
+     * This is more accurate than multiplying the length by unmoving::cos()
+     * and unmoving::sin(), which are only accurate to one step themselves.
+     */
+    constexpr void from_polar(PSXFixed angle, PSXFixed length, PSXFixed& x, PSXFixed& y) {
+        int32_t x_result = 0;
+        int32_t y_result = 0;
+        // 4096ths of a turn to 2**32ths of a turn
+        detail::cordic_rotation((uint32_t)(PSXFixed::UnderlyingType)angle << 20, length, x_result, y_result);
+        x = PSXFixed(x_result);
+        y = PSXFixed(y_result);
+    }
+}
+
+#endif // include guard